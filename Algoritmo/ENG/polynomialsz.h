@@ -21,7 +21,10 @@
  * @note Version 1.0.0: Initial implementation.
  * @note Version 1.1.0: Added Aberth method and other improvements.
  * @note Version 1.1.1: Mild corrections and improvements.
- * @note Version 1.1.2: Mild corrections and improvements.
+ * @note Version 1.1.2: Mild corrections and improvements.
+ *
+ * @note Requires GCC or Clang: the implementation uses unsigned __int128 and the
+ *       __atomic builtins, so MSVC is not supported.
  */
 
 #include <stdio.h>
@@ -45,24 +48,46 @@ extern int degreeX;
 /**
  * @brief GCD factor extracted by divideGCD()
  */
-extern int divider;
+extern long long divider;
 
 /**
  * @brief Flag indicating if factorization was complete (1) or not (0)
  */
-extern int sol;
+extern int sol;
+
+/**
+ * @brief Flag to print cubic roots as exact radicals (1) instead of decimals (0, default)
+ */
+extern int radicals;
 
-/**
- * @struct term
- * @brief Represents a single term in a polynomial.
- *
- * A term is composed of a coefficient and an exponent.
- * For example, the term 3x² has coefficient = 3 and exponent = 2.
- */
-typedef struct sterm {
-    int coefficient; /**< The coefficient of the term. */
-    int exponent;    /**< The exponent of the term. */
-} term;
+/**
+ * @struct bigInt
+ * @brief Arbitrary-precision integer stored as a sign and a magnitude in 64-bit limbs.
+ */
+typedef struct sbigint {
+    unsigned long long *limb; /**< Magnitude, least significant limb first. */
+    int size;                 /**< Number of limbs in use (0 for zero). */
+    int cap;                  /**< Number of limbs allocated. */
+    int sign;                 /**< -1, 0 or 1. */
+} bigInt;
+
+/**
+ * @struct term
+ * @brief Represents a single term in a polynomial.
+ *
+ * A term is composed of a coefficient and an exponent.
+ * For example, the term 3x² has coefficient = 3 and exponent = 2.
+ *
+ * Coefficients between -INT_MAX and INT_MAX are stored inline and big is NULL.
+ * Larger ones live in big, and coefficient then holds INT_MAX or INT_MIN with
+ * the same sign, so sign and zero tests on it stay valid. Its value is not the
+ * coefficient, so check big (or pHasBig()) before reading it as a number.
+ */
+typedef struct sterm {
+    int coefficient; /**< The coefficient of the term. */
+    int exponent;    /**< The exponent of the term. */
+    bigInt *big;     /**< Heap coefficient when it does not fit in an int, or NULL. */
+} term;
 
 /**
  * @struct polynomial
@@ -72,12 +97,70 @@ typedef struct sterm {
  */
 typedef struct spolynomial {
     term *terms;        /**< Dynamic array of polynomial terms. */
-    int numTerms;   /**< Number of terms in the polynomial. */
+    int numTerms;   /**< Number of terms in the polynomial. */
 } polynomial;
 
-void printCyclotomicRoots(int N, polynomial p);
-int findN(polynomial p);
-int dividesXPowerNMinusOne(polynomial p, int N);
+/**
+ * @struct gfPolynomial
+ * @brief Represents a dense polynomial over the finite field GF(p).
+ *
+ * coef[i] is the coefficient of x^i, reduced modulo p. The prime p must be below 2^62.
+ */
+typedef struct sgfpolynomial {
+    unsigned long long *coef; /**< Dynamic array of coefficients, indexed by exponent. */
+    int degree;               /**< Degree of the polynomial (-1 for the zero polynomial). */
+    unsigned long long p;     /**< Prime modulus. */
+} gfPolynomial;
+
+/**
+ * @struct rootInterval
+ * @brief An interval [leftNum/leftDen, rightNum/rightDen] isolating one real root.
+ *
+ * Denominators are positive and fractions are reduced. When both ends coincide the
+ * root is that rational number exactly; otherwise it lies strictly inside.
+ */
+typedef struct srootinterval {
+    long long leftNum;  /**< Numerator of the left end. */
+    long long leftDen;  /**< Denominator of the left end. */
+    long long rightNum; /**< Numerator of the right end. */
+    long long rightDen; /**< Denominator of the right end. */
+} rootInterval;
+
+/**
+ * @struct subproductTree
+ * @brief Products of (x - x_i) over halves of a fixed point set, for pEvalMulti() and pInterpolate().
+ *
+ * Node 1 is the product over all points and node i splits into nodes 2i and 2i + 1.
+ * Segments of up to TREE_LEAF_POINTS points are leaves, and they are evaluated
+ * directly. The products are kept modulo word primes, in ascending order and
+ * Montgomery form. Those for the first primes are kept while they fit in
+ * TREE_CACHE_WORDS words, and the others are rebuilt on each call.
+ */
+typedef struct ssubproducttree {
+    int numPoints;               /**< Number of points. */
+    int *points;                 /**< Copy of the points. */
+    int numNodes;                /**< Length of each table of node products. */
+    int numPrimes;               /**< Number of primes whose products are kept. */
+    long long words;             /**< Words held by the kept products. */
+    unsigned long long next;     /**< Where the search for the next prime resumes. */
+    unsigned long long *modulus; /**< The primes whose products are kept. */
+    unsigned long long *root;    /**< Non-residue generating the NTT roots of each kept prime. */
+    unsigned long long ***node;  /**< node[k][i] is node i's product modulo modulus[k], or NULL for unused indices. */
+    bigInt *weight;              /**< scale / M'(x_i), filled by the first pInterpolate(), or NULL. */
+    bigInt scale;                /**< Least common multiple of the M'(x_i). */
+} subproductTree;
+
+/**
+ * @struct qPolynomial
+ * @brief Polynomial with rational coefficients num.terms[i] / den[i].
+ *
+ * The numerators are ordinary terms, so after qPrimitive() num is the integer
+ * polynomial itself and can be passed to fac(), printFac() or any p* function.
+ */
+typedef struct sqpolynomial {
+    polynomial num; /**< Terms holding the numerators and exponents. */
+    int *den;       /**< Nonzero denominator of each term. */
+} qPolynomial;
 
 //-----------------------------------------------------------------------------
 /**
@@ -85,9 +168,33 @@ int dividesXPowerNMinusOne(polynomial p, int N);
  *
  * @param coef The coefficient of the term.
  * @param exp The expoent of the term.
- * @return T The complete term.
- */
-term setTerms(int coef, int exp);
+ * @return T The complete term.
+ */
+term setTerms(int coef, int exp);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Creates a term whose coefficient is given in decimal, of any size.
+ *
+ * The coefficient is an optional sign followed by digits; reading stops at the
+ * first other character. It is stored inline when it fits (see term).
+ *
+ * @param coef The coefficient, e.g. "-123456789012345678901234567890".
+ * @param exp The exponent of the term.
+ * @return The complete term (its heap coefficient, if any, is released by pFree()).
+ */
+term setBigTerms(const char* coef, int exp);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Tells whether any coefficient of a polynomial is held on the heap.
+ *
+ * bhaskara(), cardano(), ferrari(), binomialFac() and irreducibleFac() work on
+ * machine-size coefficients; they check this first and send such a polynomial to
+ * aberth() instead. briotRuffini() checks it to switch to multi-limb arithmetic.
+ *
+ * @param p The polynomial.
+ * @return 1 if some term has a non-NULL big, 0 otherwise.
+ */
+int pHasBig(polynomial p);
 //-----------------------------------------------------------------------------
 /**
  * @brief Returns the base of a power with an exponent equal to ind, which equals to rad.
@@ -117,7 +224,281 @@ int indOfRoot(int rad, double rt);
  * @param numTerms The number of terms the polynomial should contain.
  * @return A polynomial structure with allocated space for the specified number of terms.
  */
-polynomial pCreate(int numTerms);
+polynomial pCreate(int numTerms);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Returns a dense copy of a polynomial, with one term per exponent.
+ *
+ * The copy has terms from the highest exponent down to 0, in descending order,
+ * with zero coefficients filling the missing exponents. Repeated exponents are
+ * summed. Sparse inputs such as x^5 - x + 1 become 1, 0, 0, 0, -1, 1.
+ *
+ * @param p The polynomial (not modified).
+ * @return A new dense polynomial (its terms and heap coefficients must be freed
+ *         by the caller).
+ */
+polynomial pDense(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calculates the greatest common divisor of two polynomials over the integers.
+ *
+ * The result is gcd(content(a), content(b)) times the primitive gcd, with positive
+ * leading coefficient. The primitive gcd is computed by:
+ * 1. Heuristic GCD (GCDHEU) for degree up to GCDHEU_MAX_DEGREE: evaluates both
+ *    polynomials at an integer ξ, takes the integer gcd and reads the ξ-adic digits
+ *    back as a candidate, accepted only if it divides both polynomials;
+ * 2. Modular GCD: gcd modulo 31-bit primes, combined by the Chinese Remainder
+ *    Theorem until the candidate divides both polynomials;
+ * 3. Primitive remainder sequence, only if both methods above overflow;
+ * 4. Modular GCD on multi-limb coefficients, if the remainder sequence overflows too
+ *    or an input has coefficients on the heap, so the result is always exact;
+ *    coefficients beyond int are stored on the heap.
+ *
+ * @param a The first polynomial (not modified).
+ * @param b The second polynomial (not modified).
+ * @return A new dense polynomial with the gcd (its terms must be freed by the caller).
+ */
+polynomial pGcd(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Returns the n-th cyclotomic polynomial Phi_n.
+ *
+ * Coefficients come from a process-wide cache that is filled lazily and is safe
+ * to share between threads. Each entry is built once from the Möbius product
+ * Phi_m(x) = prod_{d|m} (1 - x^d)^mu(m/d) over the odd squarefree core m of n,
+ * using only sparse updates, and then stretched with
+ * Phi_2m(x) = Phi_m(-x) and Phi_n(x) = Phi_rad(n)(x^(n/rad(n))).
+ *
+ * @param n Order, 1 <= n < 4194304
+ * @return A new dense polynomial Phi_n, empty if n is out of range (its terms must be
+ *         freed by the caller).
+ */
+polynomial pCyclotomic(int n);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Isolates the real roots of a polynomial in disjoint rational intervals.
+ *
+ * Works on the square-free part of p with exact integer arithmetic (Vincent-Collins-
+ * Akritas with continued fractions). The positive roots are found by tracking a
+ * Möbius map M(x) = (ax + b)/(cx + d) and the polynomial whose positive roots are
+ * the preimages of the roots in (M(0), M(inf)):
+ * 1. If the polynomial has no sign variation, the branch has no roots; with one,
+ *    (M(0), M(inf)) isolates exactly one root (Descartes' rule of signs)
+ * 2. Otherwise jumps to a lower bound b on its positive roots, x -> x + b,
+ *    scaling x -> bx first when b > 16 (the continued fraction partial quotient)
+ * 3. Splits into (1, inf) by x -> x + 1 and (0, 1) by x -> 1/(x + 1)
+ *
+ * Coefficients are kept as multi-limb integers, so they never overflow; a zero
+ * constant term records M(0) as an exact root. Negative roots come from p(-x),
+ * and the unbounded interval of the largest root is closed by Cauchy's bound, or by
+ * Fujiwara's bound when Cauchy's does not fit in a long long. The square-free part
+ * is found with word-size coefficients when they fit, and with multi-limb ones for
+ * coefficients on the heap.
+ *
+ * @param p The polynomial (not modified).
+ * @param numRoots Receives the number of distinct real roots, or -1 if an
+ *                 interval end or the root bound does not fit in a long long.
+ * @return A new array of intervals sorted by their left end (must be freed by the
+ *         caller), or NULL if there are no real roots or on failure.
+ */
+rootInterval* pRealRoots(polynomial p, int* numRoots);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Shrinks an isolating interval from pRealRoots() by exact bisection.
+ *
+ * The sign of the square-free part of p at each midpoint u/v is computed exactly
+ * as v^n p(u/v). A midpoint that is a root collapses the interval onto it.
+ *
+ * @param p The same polynomial passed to pRealRoots() (not modified).
+ * @param r The interval to refine (modified in place).
+ * @param width The wanted width.
+ * @return 1 if the interval is at most width wide, 0 if the ends stopped fitting
+ *         in a long long before that.
+ */
+int pRefineRoot(polynomial p, rootInterval* r, double width);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Computes the Taylor shift p(x + a).
+ *
+ * Uses the classical Horner scheme, with an add-only path for a = 1, in O(n^2)
+ * coefficient operations. Coefficients are multi-limb integers throughout, and
+ * those of the result that do not fit in an int are returned in term.big.
+ *
+ * @param p The polynomial (not modified).
+ * @param a The shift.
+ * @return A new dense polynomial (its terms and heap coefficients must be freed
+ *         by the caller).
+ */
+polynomial pTaylorShift(polynomial p, int a);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Multiplies two polynomials.
+ *
+ * The method depends on the shorter operand: schoolbook below MUL_KARATSUBA_TERMS
+ * coefficients, Karatsuba below MUL_NTT_TERMS, and above that number-theoretic
+ * transforms modulo two primes below 2^62, joined by the Chinese remainder theorem.
+ * Two primes cover every product of int coefficients. Operands with heap
+ * coefficients are multiplied by Kronecker substitution instead.
+ *
+ * @param a The first factor (not modified).
+ * @param b The second factor (not modified).
+ * @return A new dense polynomial (its terms and heap coefficients must be freed
+ *         by the caller), or an empty polynomial if a factor is empty.
+ */
+polynomial pMul(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Raises a polynomial to a power by repeated squaring with pMul().
+ *
+ * @param p The base (not modified).
+ * @param e The exponent; p^0 is the constant 1.
+ * @return A new dense polynomial (its terms and heap coefficients must be freed
+ *         by the caller), or an empty polynomial if e < 0 or p is empty.
+ */
+polynomial pPow(polynomial p, int e);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Multiplies two sparse polynomials with the Monagan-Pearce heap.
+ *
+ * The terms of each factor are sorted and merged, then a heap holding one entry
+ * per term of the shorter factor yields the products in descending exponent
+ * order. Entries with equal exponents are chained in a single heap node. Memory
+ * stays proportional to the factors plus the result. When the term count product
+ * reaches SPARSE_MUL_DENSITY times the result degree, pMul() is used instead.
+ *
+ * @param a The first factor (not modified; terms may be unsorted or repeated).
+ * @param b The second factor (not modified; terms may be unsorted or repeated).
+ * @return A new polynomial with only nonzero terms in descending exponent order
+ *         (its terms and heap coefficients must be freed by the caller). It is
+ *         empty if the product is zero or its degree exceeds INT_MAX.
+ */
+polynomial pMulSparse(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Divides a by b with remainder, exactly over the rationals.
+ *
+ * The quotient is returned as q / d with integer q, so that d a = b q + r and
+ * deg r < deg b. d is the least positive common denominator. It is 1 when b has
+ * leading coefficient 1 or -1, and otherwise divides a power of that coefficient.
+ * Small divisors or quotients use classical pseudo-division. When both have at
+ * least DIVREM_NEWTON_TERMS coefficients and b's leading coefficient is 1 or -1,
+ * the quotient is computed modulo word primes with a Newton-iteration reciprocal
+ * and NTT products. The residues are joined by CRT until they stop changing, and
+ * the result is checked with one exact product.
+ *
+ * @param a The dividend (not modified).
+ * @param b The divisor (not modified).
+ * @param q Receives the dense quotient numerator (empty if deg a < deg b).
+ * @param r Receives the remainder numerator (empty if b divides a).
+ * @return The denominator d as a term of exponent 0, or a zero term, with q and r
+ *         empty, if b is zero. The terms and heap coefficients of q and r, and d's
+ *         heap coefficient, must be freed by the caller.
+ */
+term pDivRem(polynomial a, polynomial b, polynomial* q, polynomial* r);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Builds the subproduct tree of a point set, to be reused by pEvalMulti() and pInterpolate().
+ *
+ * The node products are computed by the first call that needs them.
+ *
+ * @param points The points (copied).
+ * @param numPoints Number of points.
+ * @return The tree, to be released with pTreeFree().
+ */
+subproductTree pTreeCreate(const int* points, int numPoints);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Evaluates a polynomial at every point of a subproduct tree.
+ *
+ * p is reduced modulo the product at the root, and each remainder is then
+ * reduced modulo the two children. The remainders reaching the leaves are
+ * evaluated directly. This runs modulo enough word primes to bound the values,
+ * which are then recovered by CRT. Each prime costs O(M(n) log n) for n points.
+ *
+ * @param p The polynomial (not modified).
+ * @param tree Tree from pTreeCreate() (node products may be added to it).
+ * @return Array with p(x_i) as terms of exponent 0, in the order of the points
+ *         (the array and its heap coefficients must be freed by the caller).
+ */
+term* pEvalMulti(polynomial p, subproductTree* tree);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Finds the polynomial of degree below n that takes the given values at the tree's n points.
+ *
+ * The result is sum v_i / M'(x_i) M(x) / (x - x_i), where M is the product at the
+ * root. Subtrees combine as left M_right + right M_left. The weights D / M'(x_i),
+ * where D is the lcm of the M'(x_i), depend only on the points. They are computed
+ * once and kept in the tree. The numerator is recovered by CRT from word primes.
+ *
+ * @param tree Tree from pTreeCreate() (its weights are filled on the first call).
+ * @param values The values at the points, one per point.
+ * @param f Receives the numerator of the interpolating polynomial.
+ * @return The least positive denominator d, so that f / d is the interpolating
+ *         polynomial, as a term of exponent 0. It is a zero term, with f empty, if
+ *         two points coincide. f's terms and all heap coefficients must be freed by
+ *         the caller.
+ */
+term pInterpolate(subproductTree* tree, const term* values, polynomial* f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Computes the resultant of two polynomials.
+ *
+ * The resultant is found modulo word primes by Euclid's algorithm, tracking the
+ * leading coefficients, and joined by CRT. The search stops as soon as a new
+ * prime leaves the value unchanged, or once the primes cover Hadamard's bound.
+ * An early stop is wrong only if the true and partial values agree modulo a
+ * 61-bit prime.
+ *
+ * @param a The first polynomial (not modified).
+ * @param b The second polynomial (not modified).
+ * @return res(a, b) as a term of exponent 0 (its heap coefficient must be freed by
+ *         the caller). It is zero if a or b is zero, or if they share a root.
+ */
+term pResultant(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Computes the discriminant of a polynomial.
+ *
+ * For p of degree n with leading coefficient c, this is
+ * (-1)^(n(n - 1)/2) res(p, p') / c, computed as in pResultant(). It is zero
+ * exactly when p has a repeated root, which is how fac() decides whether an input
+ * with heap coefficients needs a square-free split before aberth().
+ *
+ * @param p The polynomial (not modified).
+ * @return The discriminant as a term of exponent 0 (its heap coefficient must be
+ *         freed by the caller), or a zero term if p is constant.
+ */
+term pDiscriminant(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Creates a rational polynomial with the given number of terms.
+ *
+ * Terms are set as in pCreate(), through q.num.terms[i] = setTerms(a, exp) or
+ * setBigTerms(), and the denominators through q.den[i], which start at 1.
+ *
+ * @param numTerms Number of terms.
+ * @return The polynomial, to be released with qFree().
+ */
+qPolynomial qCreate(int numTerms);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Splits a rational polynomial into its content and an integer primitive part, in place.
+ *
+ * A single sweep reduces each a_i / b_i and gathers the gcd of the numerators
+ * and the lcm of the denominators, whose quotient is the content. The terms of
+ * q->num are then rewritten as the primitive part, with a positive leading
+ * coefficient, and every denominator becomes 1. No copy is made, so q->num is
+ * ready for the integer functions. As in divideGCD(), the gcd is found in 64-bit
+ * arithmetic and is 1 if every numerator is at least 2^64.
+ *
+ * @param q The polynomial (modified in place).
+ * @param den Receives the content's denominator, the lcm of the reduced denominators.
+ * @return The content's numerator, signed like the leading coefficient, so that
+ *         q = (return / den) q->num. It is a zero term, with den set to 1, if every
+ *         numerator is zero. Heap coefficients of both terms must be freed by the
+ *         caller.
+ */
+term qPrimitive(qPolynomial* q, term* den);
 //-----------------------------------------------------------------------------
 /**
  * @brief Prints the polynomial.
@@ -133,13 +514,50 @@ void pPrint(polynomial p);
  * @param b The second integer.
  * @return The greatest common divisor of a and b.
  */
-int gcd(int a, int b);
+int gcd(int a, int b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Lists the positive divisors of an integer in ascending order.
+ *
+ * The divisors are built from the prime factorization given by factorInt(). The
+ * last DIVISORS_CACHE_SIZE lists are kept in a least-recently-used cache indexed
+ * by |n|, so repeated constant terms and leading coefficients are not factored again.
+ * The cache is guarded by a spin lock, so the function may be called from several threads.
+ *
+ * @param n The integer (its sign is ignored, and it must not be 0). For INT_MIN the
+ *          divisor 2^31, which does not fit an int, is left out.
+ * @param count Output: number of divisors found.
+ * @return Dynamic array with the divisors (must be freed by the caller).
+ */
+int* divisors(int n, int* count);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Factors an integer into primes.
+ *
+ * Uses trial division by a 2·3·5 wheel up to FACTOR_WHEEL_LIMIT, then splits the
+ * remaining cofactor with Pollard's rho (Brent's variant), checking each part with
+ * isPrime().
+ *
+ * @param n The integer (its sign is ignored).
+ * @param primes Output: distinct prime factors in ascending order (room for 16).
+ * @param mult Output: multiplicity of each prime factor (room for 16).
+ * @return Number of distinct prime factors (0 for n = 0 or n = ±1).
+ */
+int factorInt(long long n, unsigned long long* primes, int* mult);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Deterministic Miller-Rabin primality test for 64-bit integers.
+ *
+ * @param n The integer to be tested.
+ * @return 1 if n is prime, 0 otherwise.
+ */
+int isPrime(unsigned long long n);
 //-----------------------------------------------------------------------------
 /**
  * @brief Generates a string representation of the factored form for a quadratic
  *        equation with integer (rational) roots and positive discriminant.
  *
- * @param aexp The exponent of the first term (2 or 4, indicating linear or quadratic factors)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -148,13 +566,13 @@ int gcd(int a, int b);
  * @param powerRoot String indicating root exponent format ("^2" for quartic, empty for quadratic)
  * @return Pointer to the formatted string buffer
  */
-char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* intSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Generates a string representation of the factored form for a quadratic
  *        equation with integer (rational) roots and negative discriminant.
  *
- * @param aexp The exponent of the first term (2 or 4, indicating linear or quadratic factors)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -163,13 +581,27 @@ char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, c
  * @param powerRoot String indicating root exponent format ("^2" for quartic, empty for quadratic)
  * @return Pointer to the formatted string buffer
  */
-char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* intSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Reduces the surd (b ± Sqrt[radicand]) / den to lowest terms.
+ *
+ * The square factors of the radicand are taken out with factorInt(), so that
+ * radicand = s^2 r with r square-free, and the common factor of b, s and den
+ * is cancelled, e.g. Sqrt[20]/2 becomes Sqrt[5].
+ *
+ * @param b The rational part (modified in place).
+ * @param den The denominator (modified in place).
+ * @param radicand The positive radicand, replaced by its square-free part r.
+ * @return The coefficient of Sqrt[r] after the cancellation.
+ */
+long long surdReduce(long long* b, long long* den, long long* radicand);
 //-----------------------------------------------------------------------------
 /**
  * @brief Generates a string representation of the factored form for a quadratic
  *        equation with irrational roots and positive discriminant.
  *
- * @param aexp The exponent of the first term (2 or 4, indicating linear or quadratic factors)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -178,13 +610,13 @@ char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, c
  * @param powerRoot String indicating root exponent format ("^2" for quartic, empty for quadratic)
  * @return Pointer to the formatted string buffer
  */
-char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* floatSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Generates a string representation of the factored form for a quadratic
  *        equation with complex irrational roots and negative discriminant.
  *
- * @param aexp The exponent of the first term (2 or 4, indicating linear or quadratic factors)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -193,13 +625,13 @@ char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta,
  * @param powerRoot String indicating root exponent format ("^2" for quartic, empty for quadratic)
  * @return Pointer to the formatted string buffer
  */
-char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* floatSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Determines the appropriate formatting function for rational roots
  *        based on discriminant sign.
  *
- * @param aexp The exponent of the first term (2 or 4)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -208,13 +640,13 @@ char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta,
  * @param powerRoot String indicating root exponent format
  * @return Pointer to the formatted string buffer
  */
-char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* rationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Determines the appropriate formatting function for irrational roots
  *        based on discriminant sign.
  *
- * @param aexp The exponent of the first term (2 or 4)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -223,7 +655,7 @@ char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char
  * @param powerRoot String indicating root exponent format
  * @return Pointer to the formatted string buffer
  */
-char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* irrationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Main simplification function that coordinates rational/irrational
@@ -233,7 +665,7 @@ char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, ch
  * whether roots are rational or irrational, then calls the appropriate
  * formatting functions.
  *
- * @param aexp The exponent of the first term (2 or 4)
+ * @param aexp The exponent of the first term (2, or 2k for factors in x^k)
  * @param den The denominator value (2a) from Bhaskara's formula
  * @param b The coefficient b from the quadratic equation
  * @param delta The discriminant value (b² - 4ac)
@@ -241,7 +673,7 @@ char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, ch
  * @param rootsPair Array containing the two calculated roots
  * @return Pointer to the formatted string buffer (must be freed by caller)
  */
-char* bhaskaraSimplify(int aexp, int den, int b, double delta, int absDelta, double* rootsPair);
+char* bhaskaraSimplify(int aexp, long long den, long long b, double delta, long long absDelta, double* rootsPair);
 //-----------------------------------------------------------------------------
 /**
  * @brief Calculates and prints the factorization of a second-degree polynomial
@@ -257,17 +689,44 @@ void bhaskara(polynomial p);
 /**
  * @brief Factors a polynomial using the Rational Root Theorem and synthetic division.
  *
- * Applies the Briot-Ruffini method to find integer roots in the range
- * [-√maxNum, √maxNum]. When a quadratic factor is found, calls bhaskara()
- * to complete factorization (including complex roots).
+ * Tests every candidate root ±r/s, where r divides the constant term and s divides
+ * the leading coefficient, and deflates the polynomial by each root found (repeated
+ * roots are deflated as many times as they occur). Roots are printed as (x - r) or
+ * (sx - r). The remainder, which has no rational roots, is split into irreducible
+ * factors by zassenhaus() and each factor is printed by irreducibleFac(). A
+ * remainder above ZASSENHAUS_MAX_DEGREE goes straight to aberth() instead.
  *
- * @param p Polynomial to be factored (modified during the process)
- * @param maxNum Largest absolute coefficient value of the original polynomial
+ * With heap coefficients (see pHasBig()) the candidates are tested exactly on
+ * multi-limb integers, as long as the leading and constant coefficients fit in a
+ * long long and give at most BIG_ROOT_CANDIDATES pairs. A linear remainder is
+ * printed exactly whatever its size. A larger one goes back through the int
+ * path if deflation brought it into int range, and to aberth() otherwise.
+ *
+ * @param p Dense polynomial to be factored (see pDense()), with a nonzero constant
+ *          term. Its terms are modified during the process.
+ * @param maxNum Unused. Candidates now come from the divisors of the leading and
+ *               constant coefficients; the parameter is kept so existing callers
+ *               still compile.
  *
  * @note The input polynomial is reduced as roots are found.
  * @note Global variable sol indicates if factorization was complete.
  */
-void briotRuffini(polynomial p, int maxNum);
+void briotRuffini(polynomial p, int maxNum);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Prints the factorization of a polynomial that is irreducible over the integers.
+ *
+ * Linear factors are printed as (sx - r), binomials ax^n + b by binomialFac() so
+ * they read the same as when fac() gets them whole, quadratic ones in closed
+ * form by bhaskara(), cyclotomic ones of higher degree as exact roots of unity by
+ * printCyclotomicRoots(), trinomials ax^2k + bx^k + c by bhaskara() as factors in
+ * x^k, cubics by cardano(), quartics by ferrari(), and the rest are approximated
+ * by aberth(). Only the (x - r) factors are printed, with no parentheses around
+ * the group, so a caller raising it to a power adds the single pair needed.
+ *
+ * @param p Dense irreducible polynomial (see pDense()).
+ */
+void irreducibleFac(polynomial p);
 //-----------------------------------------------------------------------------
 /**
  * @brief Main factorization function that coordinates all strategies.
@@ -275,10 +734,22 @@ void briotRuffini(polynomial p, int maxNum);
  * Orchestrates the complete factorization process in the following order:
  * 1. Extracts x factor (if any) via divideX() [recursive]
  * 2. Extracts coefficient GCD via divideGCD()
- * 3. If quadratic/biquadratic: uses bhaskara()
- * 4. If coefficients are sequential: uses briotRuffini()
- * 5. If coefficients are ±1: uses cyclotomicFac()
- * 6. Otherwise: uses aberth() for numerical approximation
+ * 3. If a coefficient is held on the heap: splits it with squareFree() and sends
+ *    each part to briotRuffini(), which finds rational roots exactly; parts with
+ *    multiplicity m > 1 are printed as (...)^m
+ * 4. Else, if only two terms are left, ax^n + b: uses binomialFac()
+ * 5. Else, if all coefficients are in {-1, 0, 1} or it is a product of cyclotomic
+ *    polynomials (see isCyclotomicProduct()): uses cyclotomicFac()
+ * 6. Otherwise: splits the polynomial into square-free parts with squareFree().
+ *    Parts that divide some x^N - 1 (see findN()) are printed exactly by
+ *    printCyclotomicRoots(); the others are sent once to briotRuffini(), which
+ *    deflates every rational root and factors the remainder over the integers
+ *    with zassenhaus(). Each irreducible factor goes to irreducibleFac(), which
+ *    uses bhaskara(), printCyclotomicRoots() or aberth() for numerical
+ *    approximation. A remainder above ZASSENHAUS_MAX_DEGREE skips zassenhaus()
+ *    and goes to aberth(), which solves sparse input from its Newton polygon
+ *    instead of by plain iteration. Parts with multiplicity m > 1 are printed as
+ *    (...)^m, so aberth() only ever sees simple roots
  *
  * @param p Polynomial to be factored
  *
@@ -295,8 +766,8 @@ void fac(polynomial p);
 void printFac(polynomial p);
 //-----------------------------------------------------------------------------
 /**
- * @brief Unlike `printFac()`, this alternative also deallocates the polynomial's terms
- * memory using `free(p.terms)`.
+ * @brief Unlike `printFac()`, this alternative also deallocates the polynomial's terms
+ * memory using `free(p.terms)`, along with any heap coefficient.
  *
  * @param p The polynomial to be factored.
  */
@@ -324,10 +795,140 @@ void divideX(polynomial p);
  *
  * @param p Polynomial to be simplified (modified in-place)
  *
- * @note Global variable divider stores the extracted GCD
+ * @note Global variable divider stores the extracted GCD, signed so that the
+ *       leading coefficient becomes positive
+ * @note If the GCD cannot be found in 64-bit arithmetic, which needs every
+ *       coefficient to be at least 2^63, divider is ±1 and p is left unchanged
  */
 void divideGCD(polynomial p);
 //-----------------------------------------------------------------------------
+/**
+ * @brief Computes the square-free decomposition of a polynomial over the integers.
+ *
+ * Uses Yun's algorithm on the primitive part of p: p = parts[0] · parts[1]^2 · ... ·
+ * parts[k-1]^k, where the parts are square-free, pairwise coprime, primitive and
+ * have positive leading coefficients. Parts without roots are the constant 1.
+ * If p has coefficients on the heap, or an intermediate coefficient overflows, the
+ * same algorithm runs on multi-limb coefficients, and parts may hold heap terms.
+ *
+ * @param p Polynomial with integer coefficients (not modified).
+ * @param numParts Output: number of parts (k).
+ * @return Dynamic array of dense polynomials; parts[i] has multiplicity i + 1 (the
+ *         terms of each part and the array itself must be freed by the caller).
+ */
+polynomial* squareFree(polynomial p, int* numParts);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Factors a square-free polynomial into irreducible factors over the integers.
+ *
+ * Zassenhaus algorithm:
+ * 1. Tries up to ZASSENHAUS_PRIMES odd primes p that keep the degree and the
+ *    square-free property, and keeps the one with the fewest factors mod p;
+ * 2. Factors p mod p by distinct-degree factorization and Cantor-Zassenhaus
+ *    equal-degree splitting;
+ * 3. Lifts the modular factors to p^k with multifactor Hensel lifting, where p^k is
+ *    above twice the Landau-Mignotte bound times the leading coefficient, or the
+ *    largest power below 2^62 when the bound does not fit;
+ * 4. With more than VANHOEIJ_THRESHOLD lifted factors, recombines them with van
+ *    Hoeij's knapsack: the power sums of the roots of each factor are added to a
+ *    lattice one column at a time and reduced with LLL until the short vectors
+ *    describe a partition whose products all divide p;
+ * 5. Otherwise, recombines subsets of lifted factors, smallest first, discarding a
+ *    subset early when its constant term does not divide lc·p(0), and keeps each
+ *    candidate that divides p exactly.
+ *
+ * Every factor is checked by exact division. When the bound does not fit in 62
+ * bits or the lattice does not settle, whatever is left is returned as a single
+ * factor. A p with coefficients on the heap is not factored, as its
+ * Landau-Mignotte bound is past 62 bits, and neither is one above
+ * ZASSENHAUS_MAX_DEGREE (256), since the distinct-degree step alone is cubic in
+ * the degree for each prime tried.
+ *
+ * @param p Square-free polynomial with integer coefficients (not modified).
+ * @param numFactors Output: number of factors, or -1 if p is not factored.
+ * @return Dynamic array of primitive dense factors with positive leading
+ *         coefficients (the terms of each factor and the array itself must be freed
+ *         by the caller), or NULL if p is not factored.
+ */
+polynomial* zassenhaus(polynomial p, int* numFactors);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Creates a zero polynomial over GF(p).
+ *
+ * @param degree Degree of the polynomial; degree + 1 coefficients are allocated.
+ * @param p Prime modulus, below 2^62.
+ * @return A gfPolynomial with every coefficient set to zero.
+ */
+gfPolynomial gfCreate(int degree, unsigned long long p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Reduces a polynomial with integer coefficients modulo a prime.
+ *
+ * @param p Polynomial with integer coefficients (not modified).
+ * @param prime Prime modulus, below 2^62.
+ * @return The image of p in GF(prime)[x], with the degree trimmed.
+ */
+gfPolynomial gfFromPoly(polynomial p, unsigned long long prime);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Frees the coefficients of a polynomial over GF(p).
+ *
+ * @param f Polynomial to be freed.
+ */
+void gfFree(gfPolynomial f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Frees the node products, weights and points of a subproduct tree.
+ *
+ * @param t Tree to be freed.
+ */
+void pTreeFree(subproductTree t);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Frees the terms, heap coefficients and denominators of a rational polynomial.
+ *
+ * @param q Polynomial to be freed.
+ */
+void qFree(qPolynomial q);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Prints a polynomial over GF(p), skipping zero terms, followed by its modulus.
+ *
+ * @param f Polynomial to be printed.
+ */
+void gfPrint(gfPolynomial f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Factors a polynomial into monic irreducible factors over GF(p).
+ *
+ * The polynomial is made monic and split into square-free parts (extracting p-th
+ * roots when the derivative vanishes). Each part goes through distinct-degree
+ * factorization and Cantor-Zassenhaus equal-degree splitting. Field products use
+ * Montgomery reduction, and x^p mod f is computed with sliding-window
+ * exponentiation, so primes up to 2^62 cost only about 62 modular squarings per
+ * Frobenius step.
+ *
+ * @param f Polynomial over GF(p) (not modified).
+ * @param numFactors Output: number of factors, counted with multiplicity.
+ * @return Dynamic array of factors sorted by degree; a factor of multiplicity m
+ *         appears m times. The leading coefficient of f is not returned (the
+ *         coefficients of each factor and the array itself must be freed by the
+ *         caller).
+ */
+gfPolynomial* gfFactor(gfPolynomial f, int* numFactors);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Finds the distinct roots of a polynomial in GF(p).
+ *
+ * Computes gcd(f, x^p - x), the product of the distinct linear factors of f, and
+ * splits it with Cantor-Zassenhaus.
+ *
+ * @param f Polynomial over GF(p) (not modified).
+ * @param numRoots Output: number of distinct roots.
+ * @return Dynamic array of roots in increasing order (must be freed by the caller).
+ */
+unsigned long long* gfRoots(gfPolynomial f, int* numRoots);
+//-----------------------------------------------------------------------------
 /**
  * @brief Removes zero-coefficient terms from the polynomial and reallocates memory.
  *
@@ -340,19 +941,134 @@ void divideGCD(polynomial p);
 void removeZeros(polynomial *p);
 //-----------------------------------------------------------------------------
 /**
- * @brief Factors cyclotomic polynomials (coefficients ±1).
+ * @brief Factors products of cyclotomic polynomials and ±1-coefficient polynomials.
+ *
+ * Peels off each cached Phi_d (see pCyclotomic()) that divides p, with its
+ * multiplicity, by exact division, testing only the orders d at which p vanishes
+ * at a primitive d-th root of unity modulo a prime. The linear complex factors
+ * are printed in exponential notation, grouping repeated ones as (...)^m.
  *
- * For polynomials of the form x^n + x^(n-1) + ... + x + 1 (or variations with ±1),
- * finds complex roots on the unit circle: exp(2πik/n).
- * Prints linear complex factors using exponential notation.
+ * Whatever is left after the cyclotomic factors is split with squareFree() and
+ * each part is solved directly by irreducibleFac(). Polynomials with coefficients
+ * in {-1, 0, 1} rarely have other factors over the integers, so zassenhaus() is
+ * skipped for them.
  *
- * @param p Cyclotomic polynomial to be factored
+ * @param p Product of cyclotomic polynomials (see isCyclotomicProduct()) or
+ *          polynomial with coefficients in {-1, 0, 1}
  *
- * @note Assumes polynomial has coefficients only ±1
  * @note Prints factors in format (x - Exp[i*π/m])
  */
 void cyclotomicFac(polynomial p);
 //-----------------------------------------------------------------------------
+/**
+ * @brief Prints the n roots of a binomial ax^n + b in closed form.
+ *
+ * The roots of x^n = -b/a are r * Exp[i*t*Pi/n], with t even when -b/a > 0 and
+ * odd when -b/a < 0, where r is the real n-th root of |b/a|. The largest k
+ * dividing n for which |b| and |a| are exact k-th powers of integers is taken
+ * out, checked by integer multiplication with overflow detection, so r is
+ * printed as an integer or fraction, a reduced s Sqrt[r]/d or Surd[..., n/k]. The roots
+ * are generated in increasing angle without storing them, so n can be in the
+ * millions; for b/a = ±1 the Exp[] factors match cyclotomicFac(). Real roots print
+ * as ±r and the pair at angle ±Pi/2 as ±ri, so x^2 + 4 gives (x - 2i)(x + 2i).
+ *
+ * @param p Polynomial with exactly two nonzero terms, one of them constant,
+ *          after divideGCD()
+ *
+ * @note Prints the other factors in format (x - r*Exp[i*π/m])
+ */
+void binomialFac(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Finds the smallest N such that p divides x^N - 1.
+ *
+ * p divides some x^N - 1 exactly when it is a product of distinct cyclotomic
+ * polynomials Phi_d, and the smallest such N is the lcm of those orders d.
+ * Since phi(d) >= sqrt(d/2), only orders with d <= 2n^2 and phi(d) <= n can
+ * occur, where n is the degree of p.
+ *
+ * Algorithm:
+ * 1. Rejects p unless isCyclotomicProduct() accepts it
+ * 2. Walks the candidate orders d in increasing order. Phi_d can only divide p
+ *    if p vanishes at a primitive d-th root of unity modulo a prime q = 1 (mod d),
+ *    and each such candidate is confirmed by exact division by the cached Phi_d
+ * 3. If every order divides p once and their totients add up to n, N is their lcm
+ *
+ * @param p Square-free polynomial with integer coefficients
+ * @return The smallest N, or 0 if p is not a product of cyclotomic polynomials
+ *         (always for p with coefficients on the heap)
+ */
+int findN(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Tests whether p is a product of cyclotomic polynomials.
+ *
+ * By Kronecker's theorem this holds exactly when p is monic up to sign, p(0) != 0
+ * and every root lies on the unit circle. The Graeffe step g(x^2) = ±p(x)p(-x)
+ * squares every root, which sends Phi_2m to a power of Phi_m and fixes Phi_m for
+ * odd m, so the sequence of Graeffe iterates of a product of cyclotomics reaches
+ * a fixed point within log2(2n^2) + 2 steps. Any other polynomial has a root off
+ * the unit circle and never becomes fixed. The iteration runs modulo 2^61 - 1
+ * after cheap checks for ±1 end coefficients and (anti-)palindromic symmetry.
+ *
+ * @param p Polynomial with integer coefficients (repeated factors allowed)
+ * @return 1 if p is a product of cyclotomic polynomials, 0 otherwise; the test works
+ *         on 64-bit coefficients, so it is always 0 for p with coefficients on the heap
+ */
+int isCyclotomicProduct(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Checks exactly, over the integers, whether p divides x^N - 1.
+ *
+ * Computes x^N mod p by binary powering. This is exact because p is monic up to
+ * sign, and the check fails safely if a coefficient would overflow, which includes
+ * any p with coefficients on the heap.
+ *
+ * @param p Polynomial with integer coefficients
+ * @param N Positive exponent
+ * @return 1 if p divides x^N - 1, 0 otherwise
+ */
+int dividesXPowerNMinusOne(polynomial p, int N);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Prints the exact roots of unity of a divisor of x^N - 1.
+ *
+ * Prints (x - 1) and (x + 1) for the orders 1 and 2, then each remaining root
+ * as a conjugate pair in the same notation as cyclotomicFac().
+ *
+ * @param N Value returned by findN() for p
+ * @param p Polynomial dividing x^N - 1
+ */
+void printCyclotomicRoots(int N, polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Solves an irreducible cubic in closed form (Cardano).
+ *
+ * Reduces ax^3 + bx^2 + cx + d to t^3 + pt + q and uses Cardano's formula when
+ * there is one real root, choosing the sign of the square root that avoids
+ * cancellation, or the trigonometric form 2sqrt(-p/3)cos(...) when all three
+ * roots are real. Each root is then refined by two Newton steps.
+ *
+ * If the global radicals is set, the roots are printed exactly instead, with
+ * CubeRoot[...] and Sqrt[...] for one real root or Cos[ArcCos[...]] for three.
+ *
+ * @param p Dense irreducible polynomial of degree 3
+ */
+void cardano(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Solves an irreducible quartic in closed form (Ferrari).
+ *
+ * Reduces the quartic to y^4 + py^2 + qy + r, takes the largest real root m of
+ * the resolvent cubic 8m^3 + 8pm^2 + (2p^2 - 8r)m - q^2 (solved by the same
+ * method as cardano()), and splits it into two quadratics
+ * y^2 ∓ sqrt(2m)y + p/2 + m ± q/(2sqrt(2m)). When q = 0 it is solved as a
+ * quadratic in y^2. Each root is then refined by two Newton steps.
+ *
+ * @param p Dense irreducible polynomial of degree 4
+ */
+void ferrari(polynomial p);
+//-----------------------------------------------------------------------------
 /**
  * @brief Approximates all roots of a polynomial using Aberth's method.
  *
@@ -360,11 +1076,40 @@ void cyclotomicFac(polynomial p);
  * of all roots (real and complex) of a polynomial.
  *
  * Algorithm:
- * 1. Converts coefficients to double
- * 2. Estimates maximum root radius: R = 1 + max|coef[i]/coef[0]|
- * 3. Initializes roots equally spaced on circle of radius R
- * 4. Iterates Aberth correction until convergence:
+ * 1. Writes p(x) = q(x^k), where k is the gcd of the exponents, and converts the
+ *    coefficients of q to double
+ * 2. If q is palindromic of even degree 2m, solves instead the degree-m
+ *    polynomial in y = x + 1/x, converted exactly through the Dickson
+ *    polynomials x^k + x^-k = D_k(y) (skipped if the conversion overflows),
+ *    and maps each root y back through x^2 - yx + 1 = 0, polishing both
+ *    roots with Newton steps on q
+ * 3. Otherwise, if q is a fewnomial (at most 8 nonzero terms and degree at
+ *    least 32), takes the upper convex hull of the points (e, log|c|) of its
+ *    terms: each edge from e_a to e_b holds e_b - e_a roots near the circle
+ *    of radius (|c_a|/|c_b|)^(1/(e_b - e_a)), started at the roots of the
+ *    edge's binomial. Each root is refined by Newton steps on the sparse
+ *    terms only, O(t) per step, limited to a quarter of the spacing between
+ *    the roots of its edge; roots that do not converge or coincide with
+ *    another one get Aberth corrections. If that still fails, goes on below
+ * 4. Otherwise (and also for the polynomial in y), looks for a functional
+ *    decomposition q = g(h(x)) with deg h = s, trying each divisor s of
+ *    deg q: h is normalized monic with h(0) = 0, its top
+ *    coefficients come from the power series of the r-th root of q at infinity
+ *    (r = deg q / s), and g from repeatedly dividing q by h, accepted only if
+ *    every remainder is constant to a relative 1e-12. A candidate that passes
+ *    is then confirmed exactly: the same construction is repeated with
+ *    bigInts on C^n q(x / C) / lc, first with C = 1 and then with
+ *    C = r^2 lc, so that h scales to an integer polynomial, and it is used
+ *    only if every remainder comes out exactly constant. On success, the roots
+ *    of g are found first and then, for each root c, the roots of h(x) - c,
+ *    i.e. one degree-r and r degree-s problems instead of one of degree rs
+ * 5. Otherwise, estimates the root radius with Fujiwara's bound
+ *    R = 2 * max|coef[i]/coef[0]|^(1/i), initializes the roots equally spaced
+ *    on the circle of radius R and iterates Aberth's correction until
+ *    convergence:
  *    z_k^(new) = z_k - [P(z_k)/P'(z_k)] / [1 - (P(z_k)/P'(z_k)) * Σ_{j≠k} 1/(z_k - z_j)]
+ * 6. Expands each root y of q into the k roots nrt(|y|, k) * exp(i(arg y + 2πj)/k)
+ *    of p, so each sweep costs about k² times less than on p itself
  *
  * @param p Polynomial whose roots will be approximated
  *
@@ -25,43 +25,284 @@
 char var = 'x';
 int degreeX = 0;
 int sol = 0;
-int divider = 0;
+int radicals = 0;
+long long divider = 0;
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <limits.h>
 #include <complex.h>
 
+// 128-bit products (mulMod(), bigInt limbs, the NTT) and the __atomic builtins
+// behind the divisor and cyclotomic caches have no C99 equivalent
+#if !defined(__SIZEOF_INT128__) || !defined(__ATOMIC_ACQUIRE)
+#error "polynomialsz needs GCC or Clang (unsigned __int128 and __atomic builtins)"
+#endif
+
 #define ABERTH_ITERS 68
+#define FACTOR_WHEEL_LIMIT 1000
+#define DIVISORS_CACHE_SIZE 64
+#define GCDHEU_ATTEMPTS 6
+#define GCDHEU_MAX_DEGREE 16
+#define GCD_PRIME_START 2147483647ULL
+#define ZASSENHAUS_PRIMES 5
+#define ZASSENHAUS_PRIME_LIMIT 1000
+#define ZASSENHAUS_MAX_DEGREE 256
+#define BIG_ROOT_CANDIDATES 100000
+#define VANHOEIJ_THRESHOLD 8
+#define VANHOEIJ_MARGIN 8
+#define VANHOEIJ_COLUMN_BITS 50
+#define LLL_DELTA 0.99L
+#define LLL_ETA 0.51L
+#define GF_WINDOW_BITS 4
+#define CYCLOTOMIC_PRIME 2305843009213693951ULL
+#define CYCLOTOMIC_ORDER_LIMIT 4194304
+#define CYCLOTOMIC_CACHE_BLOCK 65536
+#define FEWNOMIAL_TERMS 8
+#define FEWNOMIAL_MIN_DEGREE 32
+#define FEWNOMIAL_ITERS 60
+#define KARATSUBA_LIMBS 24
+#define MUL_KARATSUBA_TERMS 64
+#define MUL_NTT_TERMS 1024
+#define NTT_PRIME_0 4611615649683210241ULL
+#define NTT_ROOT_0 11
+#define NTT_PRIME_1 4611613450659954689ULL
+#define NTT_ROOT_1 3
+#define SPARSE_MUL_DENSITY 4
+#define DIVREM_NEWTON_TERMS 512
+#define TREE_LEAF_POINTS 16
+#define TREE_NEWTON_TERMS 64
+#define TREE_CACHE_WORDS (1 << 22)
+
+typedef struct sgffield {
+    unsigned long long p;
+    unsigned long long nInv;
+    unsigned long long r2;
+    unsigned long long one;
+} gfField;
+
+typedef struct ssparseheap {
+    unsigned long long *key;
+    int *head;
+    int *next;
+    int size;
+} sparseHeap;
+
+typedef struct svcanode {
+    bigInt *c;
+    int deg;
+    long long m[4];
+} vcaNode;
 
 int gcd(int a, int b);
+int* divisors(int n, int* count);
+int factorInt(long long n, unsigned long long* primes, int* mult);
+int totient(int n);
+int isPrime(unsigned long long n);
+int cmpInt(const void* a, const void* b);
 int indOfRoot(int rad, double rt);
 
 double nrt(double rad, int ind);
 
+unsigned long long ullGcd(unsigned long long a, unsigned long long b);
+unsigned long long mulMod(unsigned long long a, unsigned long long b, unsigned long long m);
+unsigned long long powMod(unsigned long long base, unsigned long long e, unsigned long long m);
+unsigned long long pollardRho(unsigned long long n);
+
+long long* zpFromPoly(polynomial p, int* deg);
+polynomial zpToPoly(const long long* c, int deg);
+int zpTrim(const long long* c, int deg);
+long long zpContent(const long long* c, int deg);
+void zpPrimitive(long long* c, int deg);
+int zpDerivative(const long long* c, int deg, long long* out);
+int zpDivExact(const long long* a, int da, const long long* b, int db, long long* q);
+int zpPseudoRem(long long* r, int dr, const long long* b, int db);
+int zpGcdPrs(const long long* a, int da, const long long* b, int db, long long* g);
+int zpGcdHeu(const long long* a, int da, const long long* b, int db, long long* g);
+int zpGcdModular(const long long* a, int da, const long long* b, int db, long long* g);
+int zpGcd(const long long* a, int da, const long long* b, int db, long long* g);
+int zpMulMod(const long long* a, int da, const long long* b, int db, const long long* f, int df, long long* out);
+
+unsigned long long mpInv(unsigned long long a, unsigned long long p);
+int mpTrim(const unsigned long long* c, int deg);
+int mpDivRem(unsigned long long* r, int dr, const unsigned long long* b, int db, unsigned long long m, unsigned long long* q);
+int mpMul(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long m, unsigned long long* r);
+int mpGcd(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long p, unsigned long long* g);
+int mpExtGcd(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long p, unsigned long long* s, unsigned long long* t);
+unsigned long long mpRandom(void);
+gfField gfInit(unsigned long long p);
+unsigned long long gfMulMod(const gfField* F, unsigned long long a, unsigned long long b);
+unsigned long long gfAddMod(const gfField* F, unsigned long long a, unsigned long long b);
+unsigned long long gfSubMod(const gfField* F, unsigned long long a, unsigned long long b);
+unsigned long long gfPowMod(const gfField* F, unsigned long long a, unsigned long long e);
+unsigned long long gfToMont(const gfField* F, unsigned long long a);
+unsigned long long gfFromMont(const gfField* F, unsigned long long a);
+int gfPolyMul(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* r);
+int gfPolyDivRem(const gfField* F, unsigned long long* r, int dr, const unsigned long long* b, int db, unsigned long long* q);
+int gfPolyMulMod(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, const unsigned long long* f, int df, unsigned long long* aux, unsigned long long* out);
+int gfPolyPowMod(const gfField* F, const unsigned long long* base, int dbase, unsigned long long e, const unsigned long long* f, int df, unsigned long long* out);
+int gfPolyGcd(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* g);
+int gfEqualDegree(const gfField* F, const unsigned long long* g, int dg, int d, unsigned long long** factors, int* degs, int count);
+int gfDistinctDegree(const gfField* F, const unsigned long long* f, int df, unsigned long long** factors, int* degs, int count);
+int cmpGfPoly(const void* a, const void* b);
+int cmpUll(const void* a, const void* b);
+void henselLift(const unsigned long long* F, int dF, unsigned long long* G, int dG, unsigned long long* H, int dH, unsigned long long p, unsigned long long M);
+void henselMulti(const unsigned long long* F, int dF, unsigned long long** factors, int* degs, int lo, int hi, unsigned long long p, unsigned long long M);
+int zpFromLifted(unsigned long long** factors, const int* degs, const int* idx, int count, long long lc, unsigned long long M, unsigned long long* aux, long long* g);
+int vanHoeij(const long long* f, int n, unsigned long long** factors, const int* degs, const int* live, int r, unsigned long long M, int* group);
+void lllReduce(long double** b, int rows, int cols, long double* norms);
+long long* cyclotomicBuild(int n);
+const long long* cyclotomicCached(int n);
+int* cyclotomicCandidates(int n, int* count);
+unsigned long long unityRoot(int d, unsigned long long* q);
+int cyclotomicOrders(polynomial p, const int* orders, int count, int* mult, long long* rest);
+int cmpFraction(const void* a, const void* b);
+void printUnityRoots(const int* orders, const int* mult, int count, int m);
+void squareFreeFac(polynomial p, int numeric);
+void bigBriotRuffini(polynomial p);
+long long* bigDivisors(const bigInt* x, int* count);
+int perfectPower(long long x, int k, long long* root);
+void bigInit(bigInt* x, long long v);
+void bigFree(bigInt* x);
+void bigReserve(bigInt* x, int size);
+void bigAddMul(bigInt* r, const bigInt* a, long long m);
+void bigScale(bigInt* x, long long m);
+double bigLog2(const bigInt* x);
+int bigPolySign(const bigInt* c, int deg, long long num, long long den);
+void bigAdd(bigInt* r, const bigInt* a);
+void bigDivSmall(bigInt* x, long long m);
+unsigned long long bigModSmall(const bigInt* x, unsigned long long m);
+double bigToDouble(const bigInt* x);
+void bigPrint(const bigInt* x);
+term termFromBig(bigInt* x, int exp);
+void termToBig(term t, bigInt* x);
+void termAdd(term* t, term a);
+void termFree(term* t);
+unsigned long long limbAddTo(unsigned long long* r, int nr, const unsigned long long* a, int na);
+void limbSubFrom(unsigned long long* r, int nr, const unsigned long long* a, int na);
+void limbMul(const unsigned long long* a, int na, const unsigned long long* b, int nb, unsigned long long* r);
+void bigPolyMulNonNeg(const bigInt* a, int da, const bigInt* b, int db, bigInt* r);
+void bigTaylorShift(bigInt* c, int deg, long long a);
+term termFromInt128(__int128 v, int exp);
+void termsFree(term* t, int numTerms);
+void zpMulKaratsuba(const long long* a, int na, const long long* b, int nb, __int128* r);
+void nttTransform(const gfField* F, unsigned long long* a, int n, unsigned long long g, int inverse);
+void zpMulNtt(const long long* a, int da, const long long* b, int db, __int128* r);
+void bigPolyMul(const bigInt* a, int da, const bigInt* b, int db, bigInt* r);
+void bigAddProduct(bigInt* r, const bigInt* a, const bigInt* b);
+int cmpTermDesc(const void* a, const void* b);
+term* sparseTerms(polynomial p, int* count);
+void sparseHeapPush(sparseHeap* h, unsigned long long key, int row);
+int sparseHeapPop(sparseHeap* h);
+bigInt* bigsCreate(int n);
+void bigsFree(bigInt* x, int n);
+void bigMul(bigInt* x, const bigInt* m);
+void bigPolyDivClassical(bigInt* R, int m, const bigInt* B, int n, bigInt* Q, bigInt* D);
+unsigned long long nttPrimeBelow(unsigned long long* h, unsigned long long* g);
+void gfPolyMulNtt(const gfField* F, unsigned long long g, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* r);
+void gfPolyRecip(const gfField* F, unsigned long long g, const unsigned long long* b, int n, int k, unsigned long long* inv);
+unsigned long long gfFromLong(const gfField* F, long long x);
+unsigned long long gfFromBig(const gfField* F, const bigInt* x);
+int crtStep(bigInt* x, int count, const bigInt* M, const unsigned long long* r, unsigned long long p);
+void bigPolyDivModular(const bigInt* A, int m, const bigInt* B, int n, bigInt* Q, bigInt* R);
+bigInt* bigsFromPoly(polynomial p, int* deg);
+void bigDivMod(const bigInt* a, const bigInt* b, bigInt* q, bigInt* r);
+void bigGcd(const bigInt* a, const bigInt* b, bigInt* g);
+void bigLcmRange(const bigInt* w, int lo, int hi, bigInt* out);
+long long gfTreeBuild(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, int index, int lo, int hi);
+void gfPolyRemMonic(const gfField* F, unsigned long long g, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long** recip, unsigned long long* r);
+void gfTreeEval(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, unsigned long long** recip, int index, int lo, int hi, const unsigned long long* r, unsigned long long* out);
+unsigned long long* gfTreeCombine(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, int index, int lo, int hi, const unsigned long long* c);
+void treeModular(subproductTree* t, const bigInt* f, int df, double bits, int mode, bigInt* out);
+unsigned long long gfResultant(const gfField* F, unsigned long long* a, int da, unsigned long long* b, int db);
+void bigResultantModular(const bigInt* A, int m, const bigInt* B, int n, int discriminant, bigInt* r);
+bigInt* bigPolyDivExact(const bigInt* A, int m, const bigInt* B, int n);
+int bigPolyGcd(const bigInt* A, int m, const bigInt* B, int n, bigInt* G);
+int bigPolyDerivative(const bigInt* A, int m, bigInt* D);
+polynomial bigsToPoly(bigInt* c, int deg);
+void bigsPrimitive(bigInt* c, int deg);
+polynomial* bigSquareFree(polynomial p, int* numParts);
+int vcaVariations(const bigInt* c, int deg);
+long long vcaLowerBound(const bigInt* c, int deg);
+void vcaRecord(rootInterval** list, int* count, int* cap, long long ln, long long ld, long long rn, long long rd);
+int vcaPositive(const bigInt* f, int deg, long long bound, int negate, rootInterval** list, int* count, int* cap);
+bigInt* vcaSquareFree(polynomial p, int* deg);
+int cmpInterval(const void* a, const void* b);
+
 term setTerms(int coef, int exp);
+term setBigTerms(const char* coef, int exp);
+int pHasBig(polynomial p);
 polynomial pCreate(int numTerms);
+polynomial pDense(polynomial p);
+polynomial pGcd(polynomial a, polynomial b);
+polynomial pCyclotomic(int n);
+rootInterval* pRealRoots(polynomial p, int* numRoots);
+int pRefineRoot(polynomial p, rootInterval* r, double width);
+polynomial pTaylorShift(polynomial p, int a);
+polynomial pMul(polynomial a, polynomial b);
+polynomial pPow(polynomial p, int e);
+polynomial pMulSparse(polynomial a, polynomial b);
+term pDivRem(polynomial a, polynomial b, polynomial* q, polynomial* r);
+subproductTree pTreeCreate(const int* points, int numPoints);
+term* pEvalMulti(polynomial p, subproductTree* tree);
+term pInterpolate(subproductTree* tree, const term* values, polynomial* f);
+term pResultant(polynomial a, polynomial b);
+term pDiscriminant(polynomial p);
+qPolynomial qCreate(int numTerms);
+term qPrimitive(qPolynomial* q, term* den);
+gfPolynomial gfCreate(int degree, unsigned long long p);
+gfPolynomial gfFromPoly(polynomial p, unsigned long long prime);
+gfPolynomial* gfFactor(gfPolynomial f, int* numFactors);
+unsigned long long* gfRoots(gfPolynomial f, int* numRoots);
 
 void pPrint(polynomial p);
 void printFac(polynomial p);
 void pFree(polynomial p);
+void gfFree(gfPolynomial f);
+void pTreeFree(subproductTree t);
+void qFree(qPolynomial q);
+void gfPrint(gfPolynomial f);
 void divideX(polynomial p);
 void divideGCD(polynomial p);
 void removeZeros(polynomial* p);
+polynomial* squareFree(polynomial p, int* numParts);
+polynomial* zassenhaus(polynomial p, int* numFactors);
 void fac(polynomial p);
 
 void bhaskara(polynomial p);
 void briotRuffini(polynomial p, int maxNum);
+void irreducibleFac(polynomial p);
 void cyclotomicFac(polynomial p);
+void binomialFac(polynomial p);
+void printCyclotomicRoots(int N, polynomial p);
+int findN(polynomial p);
+int isCyclotomicProduct(polynomial p);
+int dividesXPowerNMinusOne(polynomial p, int N);
+void cardano(polynomial p);
+void ferrari(polynomial p);
 void aberth(polynomial p);
-
-char* bhaskaraSimplify(int aexp, int den, int b, double delta, int absDelta, double* rootsPair);
-char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+void printRoot(double complex z);
+double complex polishRoot(const double* coef, int deg, double complex z);
+void aberthRoots(const double complex* coef, int deg, double complex* roots);
+int decomposeExact(const bigInt* exact, int n, int s);
+int decompose(const double* coef, const bigInt* exact, int n, int s, double complex* g, double complex* h);
+void compositeRoots(const double* coef, const bigInt* exact, int n, double complex* roots);
+int reciprocalRoots(const double* coef, int n, double complex* roots);
+double complex sparseNewtonStep(const double* c, const int* e, int t, double complex z);
+int cmpReal(const void* a, const void* b);
+int fewnomialRoots(const double* coef, int n, double complex* roots);
+void cubicRoots(const double* coef, double complex* roots);
+int printCubicRadicals(long long a, long long b, long long c, long long d);
+
+char* bhaskaraSimplify(int aexp, long long den, long long b, double delta, long long absDelta, double* rootsPair);
+char* rationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+char* irrationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+char* intSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+char* intSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+long long surdReduce(long long* b, long long* den, long long* radicand);
+char* floatSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+char* floatSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 
 //-----------------------------------------------------------------------------
 
@@ -70,12 +311,66 @@ term setTerms(int coef, int exp) {
 	term T;
 	T.coefficient = coef;
 	T.exponent = exp;
+	T.big = NULL;
+
+	if(coef == INT_MIN){
+
+        bigInt x;
+
+        bigInit(&x, coef);
+        T = termFromBig(&x, exp);
+	}
 
 	return T;
 }
 
 //-----------------------------------------------------------------------------
 
+term setBigTerms(const char* coef, int exp){
+
+    int negative = 0;
+    bigInt x, one;
+
+    bigInit(&x, 0);
+    bigInit(&one, 1);
+
+    if(*coef == '-' || *coef == '+') negative = (*coef++ == '-');
+
+    while(*coef >= '0' && *coef <= '9'){
+
+        long long chunk = 0, scale = 1;
+
+        for(int k = 0; k < 18 && *coef >= '0' && *coef <= '9'; k++, coef++){
+
+            chunk = chunk * 10 + (*coef - '0');
+            scale *= 10;
+        }
+
+        bigScale(&x, scale);
+        bigAddMul(&x, &one, chunk);
+    }
+
+    if(negative) x.sign = -x.sign;
+
+    bigFree(&one);
+
+    return termFromBig(&x, exp);
+}
+
+//-----------------------------------------------------------------------------
+
+int pHasBig(polynomial p){
+
+    for(int i = 0; i < p.numTerms; i++){
+
+        if(p.terms[i].big != NULL) return 1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
 double nrt(double rad, int ind){
 
     double base = (pow((fabs)(rad), 1.0/(double)(ind)));
@@ -116,6 +411,7 @@ polynomial pCreate(int numTerms) {
 
         p.terms[j].coefficient = 0;
         p.terms[j].exponent = i;
+        p.terms[j].big = NULL;
         j++;
 	}
 
@@ -124,672 +420,8720 @@ polynomial pCreate(int numTerms) {
 
 //-----------------------------------------------------------------------------
 
-void pPrint(polynomial p){
+polynomial pDense(polynomial p){
+
+    int maxExp = 0;
 
-    printf("%i%c^%i", p.terms[0].coefficient, var, p.terms[0].exponent);
+    for(int i = 0; i < p.numTerms; i++){
 
-    for(int i = 1; i < p.numTerms; i++){
-        printf(" %c %i%c^%i",
-            (p.terms[i].coefficient >= 0) ? '+' : '-',
-            (abs)(p.terms[i].coefficient), var, p.terms[i].exponent);
+        if(p.terms[i].exponent > maxExp) maxExp = p.terms[i].exponent;
     }
-}
 
-//-----------------------------------------------------------------------------
+    polynomial dense = pCreate(maxExp + 1);
 
-int gcd(int a, int b) {
+    for(int i = 0; i < p.numTerms; i++){
 
-    if(b == 0)
-        return a;
+        termAdd(&dense.terms[maxExp - p.terms[i].exponent], p.terms[i]);
+    }
 
-    return gcd(b, a % b);
+    return dense;
 }
 
 //-----------------------------------------------------------------------------
 
-void cyclotomicFac(polynomial p) {
-
-    int grau = p.terms[0].exponent;
-
-    int countRaizes = grau + 1;
-
-    if ((countRaizes % 2 == 0)) {
-
-        printf("(%c + 1)", var);
-    }
-
-    for (int k = 1; k <= grau; k++) {
+void pPrint(polynomial p){
 
-        if (k % countRaizes == 0) continue;
+    for(int i = 0; i < p.numTerms; i++){
 
-        int conjugadaK = countRaizes - k;
+        if(i > 0) printf(" %c ", (p.terms[i].coefficient >= 0) ? '+' : '-');
 
-        if (k >= conjugadaK) continue;
+        if(p.terms[i].big != NULL){
 
-        int num = 2 * k;
-        int den = countRaizes;
-        int divisor = gcd(num, den);
+            bigInt magnitude = *p.terms[i].big;
 
-        num /= divisor;
-        den /= divisor;
+            if(i > 0) magnitude.sign = 1;
 
-        if (num == 1)
-            printf("(%c - Exp[i*Pi/%d])", var, den);
-        else
-            printf("(%c - Exp[%d*i*Pi/%d])", var, num, den);
+            bigPrint(&magnitude);
+        }
+        else printf("%i", (i > 0) ? (abs)(p.terms[i].coefficient) : p.terms[i].coefficient);
 
-        if (num == 1)
-            printf("(%c - Exp[-i*Pi/%d])", var, den);
-        else
-            printf("(%c - Exp[-%d*i*Pi/%d])", var, num, den);
+        printf("%c^%i", var, p.terms[i].exponent);
     }
 }
 
 //-----------------------------------------------------------------------------
 
-char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
-
-    int numeratorSum = (-b + (int)sqrt(absDelta));
-    int numeratorSub = (-b - (int)sqrt(absDelta));
-    unsigned char divisible = (numeratorSum % den == 0 && numeratorSub % den == 0) ? 1 : 0;
+int gcd(int a, int b) {
 
-    if(divisible){
+    if(b == 0)
+        return a;
 
-            snprintf(bSimplify, 100, "(%c%s %c %i)(%c%s %c %i)", var, powerRoot,
-            ((-b + sqrt(absDelta))/den >= 0) ? '-' : '+', (abs)((numeratorSum)/den), var, powerRoot,
-            ((-b - sqrt(absDelta))/den >= 0) ? '-' : '+', (abs)((numeratorSub)/den));
-        }
+    return gcd(b, a % b);
+}
 
-        else if(!divisible && b != 0){
+//-----------------------------------------------------------------------------
 
-            snprintf(bSimplify, 100, "(%c%s - (%i + %i)/%i)(%c%s - (%i - %i)/%i)", var, powerRoot,
-             -b, (int)sqrt(absDelta), den, var, powerRoot,
-             -b, (int)sqrt(absDelta), den);
-        }
+unsigned long long ullGcd(unsigned long long a, unsigned long long b){
 
-        else{
+    while(b != 0){
 
-            snprintf(bSimplify, 100, "(%c%s %c (%i/%i))(%c%s %c (%i/%i))", var, powerRoot,
-            (-b + sqrt(absDelta) >= 0) ? '-' : '+', (int)sqrt(absDelta), den, var, powerRoot,
-            (-b + sqrt(absDelta) >= 0) ? '+' : '-', (int)sqrt(absDelta), den);
-        }
+        unsigned long long t = a % b;
 
+        a = b;
+        b = t;
+    }
 
-    return bSimplify;
+    return a;
 }
 
 //-----------------------------------------------------------------------------
 
-char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
-
-    if(-b % den == 0 && (int)sqrt(absDelta) % den == 0 && (int)sqrt(absDelta) / den != 1 && b != 0){
-        snprintf(bSimplify, 100, "(%c%s - (%i + %ii))(%c%s - (%i - %ii))", var, powerRoot,
-                -b/den, (int)sqrt(absDelta)/den, var, powerRoot, -b/den, (int)sqrt(absDelta)/den);
-    }
-    else if(-b % den == 0 && (int)sqrt(absDelta) % den == 0 && b != 0){
-        snprintf(bSimplify, 100, "(%c%s - (%i + i))(%c%s - (%i - i))", var, powerRoot,
-                -b/den, var, powerRoot, -b/den);
-    }
-    else if((-b % den != 0 || (int)sqrt(absDelta) % den != 0) && b != 0){
-        snprintf(bSimplify, 100, "(%c%s - (%i + %ii)/%i)(%c%s - (%i - %ii)/%i)", var, powerRoot,
-                -b, (int)sqrt(absDelta), den, var, powerRoot, -b, (int)sqrt(absDelta), den);
-    }
-    else if((int)sqrt(absDelta) % den == 0 && (int)sqrt(absDelta) / den != 1 && b == 0){
-        snprintf(bSimplify, 100, "(%c%s - %ii)(%c%s + %ii)", var, powerRoot,
-                (int)sqrt(absDelta)/den, var, powerRoot, (int)sqrt(absDelta)/den);
-    }
-    else if((int)sqrt(absDelta) % den == 0 && b == 0){
-        snprintf(bSimplify, 100, "(%c%s - i)(%c%s + i)", var, powerRoot, var, powerRoot);
-    }
-    else{
-        snprintf(bSimplify, 100, "(%c%s - %ii/%i)(%c%s + %ii/%i)", var, powerRoot,
-                (int)sqrt(absDelta), den, var, powerRoot, (int)sqrt(absDelta), den);
-    }
+unsigned long long mulMod(unsigned long long a, unsigned long long b, unsigned long long m){
 
-    return bSimplify;
+    return (unsigned long long)((unsigned __int128)a * b % m);
 }
 
 //-----------------------------------------------------------------------------
 
-char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
+unsigned long long powMod(unsigned long long base, unsigned long long e, unsigned long long m){
 
-    if(b != 0){
-        snprintf(bSimplify, 100, "(%c%s - ((%i + Sqrt[%i])/%i))(%c%s - ((%i - Sqrt[%i])/%i))", var, powerRoot,
-                -b, absDelta, den, var, powerRoot,
-                -b, absDelta, den);
-    }
-    else{
-        snprintf(bSimplify, 100, "(%c%s %c (Sqrt[%i]/%i))(%c%s %c (Sqrt[%i]/%i))", var, powerRoot,
-               (-b + sqrt(absDelta) >= 0) ? '-' : '+', absDelta, den, var, powerRoot,
-               (-b - sqrt(absDelta) >= 0) ? '+' : '-', absDelta, den);
-    }
+    unsigned long long result = 1 % m;
 
-    return bSimplify;
-}
+    base %= m;
 
-//-----------------------------------------------------------------------------
+    while(e > 0){
 
-char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
+        if(e & 1) result = mulMod(result, base, m);
 
-    if(b != 0){
-        snprintf(bSimplify, 100, "(%c%s - ((%i + iSqrt[%i])/%i))(%c%s - ((%i - iSqrt[%i])/%i))", var, powerRoot,
-                -b, absDelta, den, var, powerRoot,
-                -b, absDelta, den);
-    }
-    else{
-        snprintf(bSimplify, 100, "(%c%s %c (iSqrt[%i]/%i))(%c%s %c (iSqrt[%i]/%i))", var, powerRoot,
-               (-b + sqrt(absDelta) >= 0) ? '-' : '+', absDelta, den, var, powerRoot,
-               (-b - sqrt(absDelta) >= 0) ? '+' : '-', absDelta, den);
+        base = mulMod(base, base, m);
+        e >>= 1;
     }
 
-    return bSimplify;
+    return result;
 }
 
 //-----------------------------------------------------------------------------
 
-char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
+int isPrime(unsigned long long n){
 
-    if(delta >= 0)
-        return intSrPositiveDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+    static const unsigned long long bases[12] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
 
-    return intSrNegativeDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
-}
+    if(n < 2) return 0;
 
-//-----------------------------------------------------------------------------
+    for(int i = 0; i < 12; i++){
+
+        if(n % bases[i] == 0) return n == bases[i];
+    }
 
-char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot){
+    unsigned long long d = n - 1;
+    int s = 0;
 
-    if(delta >= 0){
+    while((d & 1) == 0){
 
-        return floatSrPositiveDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+        d >>= 1;
+        s++;
     }
 
-    return floatSrNegativeDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
-}
+    for(int i = 0; i < 12; i++){
 
-//-----------------------------------------------------------------------------
+        unsigned long long x = powMod(bases[i], d, n);
 
-char* bhaskaraSimplify(int aexp, int den, int b, double delta, int absDelta, double* rootsPair){
+        if(x == 1 || x == n - 1) continue;
 
-    char* bSimplify = malloc(sizeof(char) * 100);
-    char powerRoot[3] = "";
-    unsigned char perfectSquare = (round((int)sqrt(absDelta)) * round((int)sqrt(absDelta)) == absDelta) ? 1 : 0;
+        int composite = 1;
 
-    if(aexp == 4){
+        for(int r = 1; r < s && composite; r++){
 
-        snprintf(powerRoot, 3, "^2");
-    }
+            x = mulMod(x, x, n);
 
-    if(perfectSquare){
+            if(x == n - 1) composite = 0;
+        }
 
-        return rationalSqRoots(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+        if(composite) return 0;
     }
-    else{
 
-        return irrationalSqRoots(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
-    }
+    return 1;
 }
 
 //-----------------------------------------------------------------------------
 
-void bhaskara(polynomial p) {
-
-    int aexp = p.terms[0].exponent;
+unsigned long long pollardRho(unsigned long long n){
 
-    int a = 0, b = 0, c = 0;
+    if(n % 2 == 0) return 2;
 
-    for (int i = 0; i < p.numTerms; i++) {
+    for(unsigned long long c = 1; ; c++){
 
-        int expo = p.terms[i].exponent;
-        int coef = p.terms[i].coefficient;
+        unsigned long long y = 2, x = 2, q = 1, g = 1, ys = 2;
+        unsigned long long r = 1;
 
-        if (i == 0)      a = coef;
-        else if (i == 1) b = coef;
-        else if (i == 2) c = coef;
-    }
+        while(g == 1){
 
-    int den = 2 * p.terms[0].coefficient;
+            x = y;
 
-    double delta = pow(b, 2) - (4 * a * c);
-    double rootsPair[2] = {0, 0};
+            for(unsigned long long i = 0; i < r; i++) y = (mulMod(y, y, n) + c) % n;
 
-    int absDelta = (int)(fabs)(delta);
+            for(unsigned long long k = 0; k < r && g == 1; k += 128){
 
-    rootsPair[0] = (-b + sqrt(absDelta)) / den;
-    rootsPair[1] = (-b - sqrt(absDelta)) / den;
+                ys = y;
 
-    int asbRoot1 = (int)(fabs)(rootsPair[0]);
-    int asbRoot2 = (int)(fabs)(rootsPair[1]);
+                for(unsigned long long i = 0; i < 128 && i < r - k; i++){
 
-    char* bSimplify = bhaskaraSimplify(aexp, den, b, delta, absDelta, rootsPair);
+                    y = (mulMod(y, y, n) + c) % n;
+                    q = mulMod(q, (x > y) ? x - y : y - x, n);
+                }
 
-    int negRoot = (rootsPair[0] <= 0 || rootsPair[1] <= 0 || (aexp == 4 && delta >= 0)) ? 1 : -1;
+                g = ullGcd(q, n);
+            }
 
+            r <<= 1;
+        }
 
-    if(negRoot == 1){
+        if(g == n){
 
-        printf("%s", bSimplify);
-    }
-    else if(aexp == 4){
+            do{
 
-        printf("(%c %c %i)(%c %c %i)(%c %c %i)(%c %c %i)", var, (-b + sqrt(absDelta) >= 0) ? '-' : '+', asbRoot1,
-                                                   var, (-b + sqrt(absDelta) >= 0) ? '+' : '-', asbRoot1,
-                                                   var, (-b - sqrt(absDelta) >= 0) ? '-' : '+', asbRoot2,
-                                                   var, (-b - sqrt(absDelta) >= 0) ? '+' : '-', asbRoot2);
-    }
-    else{
+                ys = (mulMod(ys, ys, n) + c) % n;
+                g = ullGcd((x > ys) ? x - ys : ys - x, n);
+            } while(g == 1);
+        }
 
-        printf("(%c %c %i)(%c %c %i)", var, (-b + sqrt(absDelta) >= 0) ? '-' : '+', asbRoot1,
-                                   var, (-b - sqrt(absDelta) >= 0) ? '-' : '+', asbRoot2);
+        if(g != n) return g;
     }
-
-    free(bSimplify);
 }
 
 //-----------------------------------------------------------------------------
 
-void briotRuffini(polynomial p, int maxNum){
+int factorInt(long long n, unsigned long long* primes, int* mult){
 
-    int step = 1, i = 0, r = 0, rnum = 1, cont = 1;
-    int aexp = p.terms[0].exponent;
-    int numTermsATM = p.numTerms;
-    double ind = 1, stepf = 1;
+    static const int wheel[8] = {4, 2, 4, 2, 4, 6, 2, 6};
 
-    int *root = (int*)calloc(p.numTerms, sizeof(int));
+    unsigned long long m = (n < 0) ? -(unsigned long long)n : (unsigned long long)n;
+    unsigned long long stack[64];
+    int numPrimes = 0, top = 0;
 
-	while (i <= sqrt(maxNum) && aexp != r) {
+    if(m == 0) return 0;
 
-		step = p.terms[0].coefficient;
-        polynomial aux = pCreate(numTermsATM);
-        aux.terms[0] = setTerms(step, p.terms[0].exponent - 1);
+    for(unsigned long long d = 2; d <= 5; d += (d == 2) ? 1 : 2){
 
-		for (int k = 1; k < numTermsATM; k++) {
+        if(m % d == 0){
 
-			step = i * step + p.terms[k].coefficient;
-			aux.terms[k] = setTerms(step, p.terms[k].exponent - 1);
-        }
+            primes[numPrimes] = d;
+            mult[numPrimes] = 0;
 
+            while(m % d == 0){
 
-        if (step == 0) {
+                m /= d;
+                mult[numPrimes]++;
+            }
 
-            root[r] = i;
-            r++;
+            numPrimes++;
+        }
+    }
 
-            for(int j = 0; j < numTermsATM - 1; j++){
+    for(unsigned long long d = 7, w = 0; d <= FACTOR_WHEEL_LIMIT && d * d <= m; d += wheel[w], w = (w + 1) % 8){
 
-                p.terms[j] = aux.terms[j];
-            }
+        if(m % d != 0) continue;
 
-            numTermsATM--;
+        primes[numPrimes] = d;
+        mult[numPrimes] = 0;
+
+        while(m % d == 0){
+
+            m /= d;
+            mult[numPrimes]++;
         }
-        else i++;
 
-        free(aux.terms);
-	}
+        numPrimes++;
+    }
+
+    if(m > 1) stack[top++] = m;
+
+    while(top > 0){
 
-	if (r < aexp) {
+        unsigned long long f = stack[--top];
 
-		i = -(int)(sqrt(maxNum));
+        if((unsigned __int128)FACTOR_WHEEL_LIMIT * FACTOR_WHEEL_LIMIT >= f || isPrime(f)){
 
-		while (i != 0 && aexp != r) {
+            int k = 0;
 
-            step = p.terms[0].coefficient;
-            polynomial aux = pCreate(numTermsATM);
-            aux.terms[0] = setTerms(step, p.terms[0].exponent - 1);
+            while(k < numPrimes && primes[k] != f) k++;
 
-            for (int k = 1; k < numTermsATM; k++) {
+            if(k == numPrimes){
 
-                step = i * step + p.terms[k].coefficient;
-                aux.terms[k] = setTerms(step, p.terms[k].exponent - 1);
+                primes[numPrimes] = f;
+                mult[numPrimes++] = 0;
             }
 
-            if (step == 0) {
+            mult[k]++;
+            continue;
+        }
 
-                root[r] = i;
-                r++;
+        unsigned long long g = pollardRho(f);
 
-                for(int j = 0; j < numTermsATM - 1; j++){
+        stack[top++] = g;
+        stack[top++] = f / g;
+    }
 
-                    p.terms[j] = aux.terms[j];
-                }
+    for(int i = 1; i < numPrimes; i++){
 
-                numTermsATM--;
-            }
-            else i++;
+        for(int j = i; j > 0 && primes[j-1] > primes[j]; j--){
 
-            free(aux.terms);
+            unsigned long long tp = primes[j];
+            int tm = mult[j];
+
+            primes[j] = primes[j-1];
+            mult[j] = mult[j-1];
+            primes[j-1] = tp;
+            mult[j-1] = tm;
         }
     }
 
-    p.numTerms = numTermsATM;
+    return numPrimes;
+}
 
-    float zeroAux = 0;
+//-----------------------------------------------------------------------------
 
-	if (r > 0) {
+int cmpInt(const void* a, const void* b){
 
-		for (int l = 0; ((root[l] == 0 && l == 0) || root[l] != 0) && l < aexp; l++) {
+    int x = *(const int*)a, y = *(const int*)b;
 
-            if(root[l] == 0){
+    return (x > y) - (x < y);
+}
 
-                zeroAux = 1.5;
+//-----------------------------------------------------------------------------
 
-                printf("%c", var);
-            }
-            else{
-                printf("(%c %c %i)", var, ((root[l] > 0) ? '-' : '+'), abs(root[l]));
-            }
-        }
+int* divisors(int n, int* count){
 
-            if(r < aexp){
+    static unsigned int cacheKey[DIVISORS_CACHE_SIZE];
+    static int cacheCount[DIVISORS_CACHE_SIZE];
+    static int* cacheList[DIVISORS_CACHE_SIZE];
+    static unsigned long cacheUse[DIVISORS_CACHE_SIZE];
+    static unsigned long useClock = 0;
+    static char lock = 0;
 
-                removeZeros(&p);
+    unsigned long long primes[16];
+    int mult[16];
+    unsigned int key = (n < 0) ? 0u - (unsigned int)n : (unsigned int)n;
+    int slot = 0;
 
-                if (p.terms[0].exponent == 2 && p.numTerms == 3) {
+    while(__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE));
 
-                    if (zeroAux != 1.5 && zeroAux != 0) {
+    useClock++;
 
-                        printf("(%c %c %d)", var, (zeroAux > 0) ? '-' : '+', (int)fabs(zeroAux));
-                    }
+    for(int i = 0; i < DIVISORS_CACHE_SIZE; i++){
 
-                    bhaskara(p);
-                    sol = 1;
-                    return;
-                }
+        if(cacheList[i] != NULL && cacheKey[i] == key){
 
-                if (p.terms[0].exponent == 4 && p.numTerms == 3 && p.terms[1].exponent == 2) {
+            slot = i;
+            break;
+        }
 
-                    polynomial quad = pCreate(3);
+        if(cacheList[i] == NULL || cacheUse[i] < cacheUse[slot]) slot = i;
+    }
 
-                    quad.terms[0] = setTerms(p.terms[0].coefficient, 4);
-                    quad.terms[1] = setTerms(p.terms[1].coefficient, 2);
-                    quad.terms[2] = setTerms(p.terms[2].coefficient, 0);
+    if(cacheList[slot] == NULL || cacheKey[slot] != key){
 
-                    if (zeroAux != 1.5 && zeroAux != 0) {
+        int numPrimes = factorInt(n, primes, mult);
+        int total = 1;
 
-                        printf("(%c %c %d)", var, (zeroAux > 0) ? '-' : '+', (int)fabs(zeroAux));
-                    }
+        for(int i = 0; i < numPrimes; i++) total *= mult[i] + 1;
 
-                    bhaskara(quad);
-                    sol = 1;
-                    return;
-            }
-        }
-	}
+        int *list = (int*)realloc(cacheList[slot], total * sizeof(int));
 
-	if(r == aexp) sol = 1;
-	else{
-        aberth(p);
-        sol = 1;
-	}
+        if(list == NULL){
 
-    free(root);
-    return;
-}
+            printf("\nError allocating memory.");
+            exit(1);
+        }
 
-//-----------------------------------------------------------------------------
+        int size = 1;
+        list[0] = 1;
 
-void removeZeros(polynomial *p) {
+        for(int i = 0; i < numPrimes; i++){
 
-    if (p == NULL || p->terms == NULL || p->numTerms == 0) return;
+            int prev = size;
+            long long power = 1;
 
-    int indexWrite = 0;
+            for(int e = 1; e <= mult[i]; e++){
 
-    for (int indexRead = 0; indexRead < p->numTerms; indexRead++) {
-        if (p->terms[indexRead].coefficient != 0) {
-            if (indexWrite != indexRead) {
+                power *= (long long)primes[i];
 
-                p->terms[indexWrite] = p->terms[indexRead];
-            }
+                for(int j = 0; j < prev; j++){
 
-            indexWrite++;
+                    if(list[j] * power <= INT_MAX) list[size++] = (int)(list[j] * power);
+                }
+            }
         }
+
+        qsort(list, size, sizeof(int), cmpInt);
+
+        cacheKey[slot] = key;
+        cacheCount[slot] = size;
+        cacheList[slot] = list;
     }
 
-    if (indexWrite == p->numTerms) return;
+    cacheUse[slot] = useClock;
 
-    if (indexWrite == 0) {
+    int *result = (int*)malloc(cacheCount[slot] * sizeof(int));
 
-        free(p->terms);
-        p->terms = NULL;
-        p->numTerms = 0;
-        return;
+    if(result == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
     }
 
-    term *temp = (term*)realloc(p->terms, indexWrite * sizeof(term));
+    for(int i = 0; i < cacheCount[slot]; i++) result[i] = cacheList[slot][i];
 
-    if (temp != NULL) {
+    *count = cacheCount[slot];
 
-        p->terms = temp;
-        p->numTerms = indexWrite;
-    } else {
+    __atomic_clear(&lock, __ATOMIC_RELEASE);
 
-        p->numTerms = indexWrite;
-    }
+    return result;
 }
 
 //-----------------------------------------------------------------------------
 
-void fac(polynomial p) {
+long long* zpFromPoly(polynomial p, int* deg){
 
-    int qtZeros = 0;
-    int maxNum = 0;
     int maxExp = 0;
-    int binary = 1;
-    int sequence = 1;
-    int maxCoefOne = 0;
 
-    sol = 0;
+    for(int i = 0; i < p.numTerms; i++){
 
-    for (int i = 0; i < p.numTerms; i++) {
+        // heap coefficients are left to the multi-limb routines
+        if(p.terms[i].big != NULL) return NULL;
 
-        binary *= p.terms[i].exponent;
+        if(p.terms[i].exponent > maxExp) maxExp = p.terms[i].exponent;
     }
 
-    if (binary != 0){
+    long long *c = (long long*)calloc(maxExp + 1, sizeof(long long));
 
-        divideX(p);
-        return;
+    if(c == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
     }
 
-    divideGCD(p);
+    for(int i = 0; i < p.numTerms; i++){
 
-    for (int j = 0; j < p.numTerms; j++) {
+        c[p.terms[i].exponent] += p.terms[i].coefficient;
+    }
 
-        if (sequence == 1 && j > 0 && p.terms[j-1].exponent != p.terms[j].exponent + 1) {
+    *deg = zpTrim(c, maxExp);
 
-            maxCoefOne = 0;
-            sequence = 0;
-        }
+    return c;
+}
 
-        maxCoefOne += (p.terms[j].coefficient);
+//-----------------------------------------------------------------------------
 
-		maxNum = (abs(p.terms[j].coefficient) > abs(maxNum)) ? abs(p.terms[j].coefficient) : abs(maxNum);
-		maxExp = (p.terms[j].exponent > maxExp) ? p.terms[j].exponent : maxExp;
-    }
+polynomial zpToPoly(const long long* c, int deg){
 
-    for (int i = 0; i < p.numTerms; i++){
+    polynomial p = pCreate(deg + 1);
+
+    for(int i = 0; i <= deg; i++){
 
-        if(p.terms[i].coefficient == 0) qtZeros++;
+        p.terms[deg - i] = termFromInt128(c[i], i);
     }
 
-    if(divider > 1 || divider < -1) printf("%i", divider);
+    return p;
+}
 
-    if(degreeX != 0){
+//-----------------------------------------------------------------------------
 
-        printf("%c^%d", var, degreeX);
+int zpTrim(const long long* c, int deg){
 
-        if(maxExp == 0){
+    while(deg >= 0 && c[deg] == 0) deg--;
 
-            printf("\n\n");
-            return;
-        }
-    }
+    return deg;
+}
 
-    if((p.numTerms == 3) && (p.terms[0].exponent < 5) && (p.terms[0].exponent % 2 == 0) && (p.terms[1].exponent == 1 && p.terms[0].exponent == 2 || p.terms[1].exponent == 2)) {
+//-----------------------------------------------------------------------------
 
-        bhaskara(p);
-        sol = 1;
-    }
-    if(sequence == 1 && maxCoefOne != p.numTerms && sol == 0){
+long long zpContent(const long long* c, int deg){
 
-        briotRuffini(p, maxNum);
-    }
-    else if(maxCoefOne == p.numTerms && p.terms[0].exponent % 2 == 0 && sol == 0){
+    long long g = 0;
 
-        cyclotomicFac(p);
-        sol = 1;
-        degreeX = 0;
-        printf("\n\n");
-        return;
-    }
-    if(sol == 0){
+    for(int i = 0; i <= deg && g != 1; i++){
 
-        aberth(p);
+        g = (long long)ullGcd((unsigned long long)g, (unsigned long long)((c[i] < 0) ? -c[i] : c[i]));
     }
 
-    degreeX = 0;
+    return g;
+}
+
+//-----------------------------------------------------------------------------
+
+void zpPrimitive(long long* c, int deg){
+
+    long long g = zpContent(c, deg);
+
+    if(g == 0) return;
+
+    if(c[deg] < 0) g = -g;
+
+    for(int i = 0; i <= deg; i++) c[i] /= g;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpDerivative(const long long* c, int deg, long long* out){
+
+    for(int i = 1; i <= deg; i++) out[i-1] = c[i] * i;
+
+    return zpTrim(out, deg - 1);
+}
+
+//-----------------------------------------------------------------------------
+
+int zpDivExact(const long long* a, int da, const long long* b, int db, long long* q){
+
+    long long *r = (long long*)malloc((da + 1) * sizeof(long long));
+
+    if(r == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) r[i] = a[i];
+
+    int exact = 1;
+
+    for(int i = da - db; i >= 0 && exact; i--){
+
+        if(r[i + db] % b[db] != 0){
+
+            exact = 0;
+            break;
+        }
+
+        q[i] = r[i + db] / b[db];
+
+        for(int j = 0; j <= db && exact; j++){
+
+            long long prod;
+
+            if(__builtin_mul_overflow(q[i], b[j], &prod) || __builtin_sub_overflow(r[i + j], prod, &r[i + j])) exact = 0;
+        }
+    }
+
+    for(int i = 0; i < db && i <= da && exact; i++){
+
+        if(r[i] != 0) exact = 0;
+    }
+
+    free(r);
+
+    return exact;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpPseudoRem(long long* r, int dr, const long long* b, int db){
+
+    while(dr >= db && dr >= 0){
+
+        long long lead = r[dr];
+
+        for(int i = 0; i <= dr; i++){
+
+            long long prod;
+
+            if(__builtin_mul_overflow(r[i], b[db], &r[i])) return -2;
+
+            if(i >= dr - db){
+
+                if(__builtin_mul_overflow(lead, b[i - (dr - db)], &prod) || __builtin_sub_overflow(r[i], prod, &r[i])) return -2;
+            }
+        }
+
+        dr = zpTrim(r, dr - 1);
+
+        if(dr >= 0) zpPrimitive(r, dr);
+    }
+
+    return dr;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpGcdPrs(const long long* a, int da, const long long* b, int db, long long* g){
+
+    int size = ((da > db) ? da : db) + 1;
+    long long *u = (long long*)calloc(size, sizeof(long long));
+    long long *v = (long long*)calloc(size, sizeof(long long));
+
+    if(u == NULL || v == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) u[i] = a[i];
+    for(int i = 0; i <= db; i++) v[i] = b[i];
+
+    if(da < db){
+
+        long long *t = u;
+        int dt = da;
+
+        u = v;
+        v = t;
+        da = db;
+        db = dt;
+    }
+
+    if(da >= 0) zpPrimitive(u, da);
+    if(db >= 0) zpPrimitive(v, db);
+
+    while(db >= 0){
+
+        int dr = zpPseudoRem(u, da, v, db);
+
+        if(dr == -2){
+
+            da = -2;
+            break;
+        }
+
+        long long *t = u;
+
+        u = v;
+        v = t;
+        da = db;
+        db = dr;
+    }
+
+    if(da == 0) u[0] = 1;
+
+    for(int i = 0; i <= da; i++) g[i] = u[i];
+
+    free(u);
+    free(v);
+
+    return da;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long mpInv(unsigned long long a, unsigned long long m){
+
+    __int128 t = 0, newT = 1, r = m, newR = a % m;
+
+    while(newR != 0){
+
+        __int128 q = r / newR, aux = t - q * newT;
+
+        t = newT;
+        newT = aux;
+        aux = r - q * newR;
+        r = newR;
+        newR = aux;
+    }
+
+    if(r != 1) return 0;
+    if(t < 0) t += m;
+
+    return (unsigned long long)t;
+}
+
+//-----------------------------------------------------------------------------
+
+int mpTrim(const unsigned long long* c, int deg){
+
+    while(deg >= 0 && c[deg] == 0) deg--;
+
+    return deg;
+}
+
+//-----------------------------------------------------------------------------
+
+int mpDivRem(unsigned long long* r, int dr, const unsigned long long* b, int db, unsigned long long m, unsigned long long* q){
+
+    unsigned long long inv = mpInv(b[db], m);
+
+    dr = mpTrim(r, dr);
+
+    if(q != NULL){
+
+        for(int i = 0; i <= dr - db; i++) q[i] = 0;
+    }
+
+    while(dr >= db){
+
+        unsigned long long lead = mulMod(r[dr], inv, m);
+
+        if(q != NULL) q[dr - db] = lead;
+
+        for(int j = 0; j <= db; j++){
+
+            r[dr - db + j] = (r[dr - db + j] + m - mulMod(lead, b[j], m)) % m;
+        }
+
+        dr = mpTrim(r, dr - 1);
+    }
+
+    return dr;
+}
+
+//-----------------------------------------------------------------------------
+
+int mpMul(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long m, unsigned long long* r){
+
+    if(da < 0 || db < 0) return -1;
+
+    for(int i = 0; i <= da + db; i++) r[i] = 0;
+
+    for(int i = 0; i <= da; i++){
+
+        if(a[i] == 0) continue;
+
+        for(int j = 0; j <= db; j++){
+
+            r[i + j] = (r[i + j] + mulMod(a[i], b[j], m)) % m;
+        }
+    }
+
+    return mpTrim(r, da + db);
+}
+
+//-----------------------------------------------------------------------------
+
+int mpGcd(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long p, unsigned long long* g){
+
+    int size = ((da > db) ? da : db) + 1;
+    unsigned long long *u = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    unsigned long long *v = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+
+    if(u == NULL || v == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) u[i] = a[i];
+    for(int i = 0; i <= db; i++) v[i] = b[i];
+
+    da = mpTrim(u, da);
+    db = mpTrim(v, db);
+
+    while(db >= 0){
+
+        int dr = mpDivRem(u, da, v, db, p, NULL);
+        unsigned long long *t = u;
+
+        u = v;
+        v = t;
+        da = db;
+        db = dr;
+    }
+
+    if(da >= 0){
+
+        unsigned long long inv = mpInv(u[da], p);
+
+        for(int i = 0; i <= da; i++) g[i] = mulMod(u[i], inv, p);
+    }
+
+    free(u);
+    free(v);
+
+    return da;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long mpRandom(void){
+
+    static unsigned long long state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+//-----------------------------------------------------------------------------
+
+int mpExtGcd(const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long p, unsigned long long* s, unsigned long long* t){
+
+    int size = da + db + 2;
+    unsigned long long *r0 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *r1 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *s0 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *s1 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *t0 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *t1 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *q = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * size, sizeof(unsigned long long));
+
+    if(r0 == NULL || r1 == NULL || s0 == NULL || s1 == NULL || t0 == NULL || t1 == NULL || q == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) r0[i] = a[i];
+    for(int i = 0; i <= db; i++) r1[i] = b[i];
+
+    int dr0 = mpTrim(r0, da), dr1 = mpTrim(r1, db);
+    int ds0 = 0, ds1 = -1, dt0 = -1, dt1 = 0;
+
+    s0[0] = 1;
+    t1[0] = 1;
+
+    while(dr1 >= 0){
+
+        int dq = dr0 - dr1;
+        int dr = mpDivRem(r0, dr0, r1, dr1, p, q);
+
+        dq = mpTrim(q, dq);
+
+        int dn = mpMul(q, dq, s1, ds1, p, aux);
+
+        for(int i = 0; i <= ((ds0 > dn) ? ds0 : dn); i++){
+
+            unsigned long long x = (i <= ds0) ? s0[i] : 0, y = (i <= dn) ? aux[i] : 0;
+
+            s0[i] = (x + p - y) % p;
+        }
+
+        ds0 = mpTrim(s0, (ds0 > dn) ? ds0 : dn);
+        dn = mpMul(q, dq, t1, dt1, p, aux);
+
+        for(int i = 0; i <= ((dt0 > dn) ? dt0 : dn); i++){
+
+            unsigned long long x = (i <= dt0) ? t0[i] : 0, y = (i <= dn) ? aux[i] : 0;
+
+            t0[i] = (x + p - y) % p;
+        }
+
+        dt0 = mpTrim(t0, (dt0 > dn) ? dt0 : dn);
+
+        unsigned long long *swap = r0;
+        r0 = r1;
+        r1 = swap;
+        swap = s0;
+        s0 = s1;
+        s1 = swap;
+        swap = t0;
+        t0 = t1;
+        t1 = swap;
+
+        int dswap = ds0;
+        ds0 = ds1;
+        ds1 = dswap;
+        dswap = dt0;
+        dt0 = dt1;
+        dt1 = dswap;
+        dr0 = dr1;
+        dr1 = dr;
+    }
+
+    unsigned long long inv = mpInv(r0[dr0], p);
+
+    for(int i = 0; i <= db; i++) s[i] = (i <= ds0) ? mulMod(s0[i], inv, p) : 0;
+    for(int i = 0; i <= da; i++) t[i] = (i <= dt0) ? mulMod(t0[i], inv, p) : 0;
+
+    free(r0);
+    free(r1);
+    free(s0);
+    free(s1);
+    free(t0);
+    free(t1);
+    free(q);
+    free(aux);
+
+    return dr0;
+}
+
+//-----------------------------------------------------------------------------
+
+gfField gfInit(unsigned long long p){
+
+    gfField F;
+    unsigned long long inv = p;
+
+    for(int i = 0; i < 5; i++) inv *= 2 - p * inv;
+
+    F.p = p;
+    F.nInv = (p & 1) ? 0 - inv : 0;
+    F.one = (p & 1) ? (0 - p) % p : 1 % p;
+    F.r2 = mulMod(F.one, F.one, p);
+
+    return F;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfMulMod(const gfField* F, unsigned long long a, unsigned long long b){
+
+    if(F->nInv == 0) return mulMod(a, b, F->p);
+
+    unsigned __int128 t = (unsigned __int128)a * b;
+    unsigned long long m = (unsigned long long)t * F->nInv;
+    unsigned long long r = (unsigned long long)((t + (unsigned __int128)m * F->p) >> 64);
+
+    return (r >= F->p) ? r - F->p : r;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfAddMod(const gfField* F, unsigned long long a, unsigned long long b){
+
+    unsigned long long s = a + b;
+
+    return (s >= F->p) ? s - F->p : s;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfSubMod(const gfField* F, unsigned long long a, unsigned long long b){
+
+    return (a >= b) ? a - b : a + F->p - b;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfPowMod(const gfField* F, unsigned long long a, unsigned long long e){
+
+    unsigned long long r = F->one;
+
+    while(e > 0){
+
+        if(e & 1) r = gfMulMod(F, r, a);
+
+        a = gfMulMod(F, a, a);
+        e >>= 1;
+    }
+
+    return r;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfToMont(const gfField* F, unsigned long long a){
+
+    return gfMulMod(F, a % F->p, F->r2);
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfFromMont(const gfField* F, unsigned long long a){
+
+    return gfMulMod(F, a, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+int gfPolyMul(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* r){
+
+    if(da < 0 || db < 0) return -1;
+
+    for(int i = 0; i <= da + db; i++) r[i] = 0;
+
+    for(int i = 0; i <= da; i++){
+
+        if(a[i] == 0) continue;
+
+        for(int j = 0; j <= db; j++) r[i + j] = gfAddMod(F, r[i + j], gfMulMod(F, a[i], b[j]));
+    }
+
+    return mpTrim(r, da + db);
+}
+
+//-----------------------------------------------------------------------------
+
+int gfPolyDivRem(const gfField* F, unsigned long long* r, int dr, const unsigned long long* b, int db, unsigned long long* q){
+
+    unsigned long long inv = gfPowMod(F, b[db], F->p - 2);
+
+    dr = mpTrim(r, dr);
+
+    if(q != NULL){
+
+        for(int i = 0; i <= dr - db; i++) q[i] = 0;
+    }
+
+    while(dr >= db){
+
+        unsigned long long lead = gfMulMod(F, r[dr], inv);
+
+        if(q != NULL) q[dr - db] = lead;
+
+        for(int j = 0; j < db; j++) r[dr - db + j] = gfSubMod(F, r[dr - db + j], gfMulMod(F, lead, b[j]));
+
+        r[dr] = 0;
+        dr = mpTrim(r, dr - 1);
+    }
+
+    return dr;
+}
+
+//-----------------------------------------------------------------------------
+
+int gfPolyMulMod(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, const unsigned long long* f, int df, unsigned long long* aux, unsigned long long* out){
+
+    int dr = gfPolyDivRem(F, aux, gfPolyMul(F, a, da, b, db, aux), f, df, NULL);
+
+    for(int i = 0; i <= dr; i++) out[i] = aux[i];
+
+    return dr;
+}
+
+//-----------------------------------------------------------------------------
+
+int gfPolyPowMod(const gfField* F, const unsigned long long* base, int dbase, unsigned long long e, const unsigned long long* f, int df, unsigned long long* out){
+
+    int size = ((dbase > 2 * df) ? dbase : 2 * df) + 1;
+    int half = 1 << (GF_WINDOW_BITS - 1);
+    int *dtable = (int*)malloc(half * sizeof(int));
+    unsigned long long **table = (unsigned long long**)malloc(half * sizeof(unsigned long long*));
+    unsigned long long *sq = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+
+    if(dtable == NULL || table == NULL || sq == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i < half; i++){
+
+        table[i] = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+
+        if(table[i] == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+    }
+
+    for(int i = 0; i <= dbase; i++) table[0][i] = base[i];
+
+    dtable[0] = gfPolyDivRem(F, table[0], dbase, f, df, NULL);
+
+    int dsq = gfPolyMulMod(F, table[0], dtable[0], table[0], dtable[0], f, df, aux, sq);
+
+    for(int i = 1; i < half; i++) dtable[i] = gfPolyMulMod(F, table[i-1], dtable[i-1], sq, dsq, f, df, aux, table[i]);
+
+    int dout = 0, started = 0;
+
+    out[0] = F->one;
+
+    for(int i = 63; i >= 0; ){
+
+        if(!((e >> i) & 1)){
+
+            if(started) dout = gfPolyMulMod(F, out, dout, out, dout, f, df, aux, out);
+
+            i--;
+            continue;
+        }
+
+        int j = (i >= GF_WINDOW_BITS - 1) ? i - GF_WINDOW_BITS + 1 : 0;
+
+        while(!((e >> j) & 1)) j++;
+
+        int window = (int)((e >> j) & ((1ULL << (i - j + 1)) - 1));
+
+        for(int k = 0; started && k <= i - j; k++) dout = gfPolyMulMod(F, out, dout, out, dout, f, df, aux, out);
+
+        if(started){
+
+            dout = gfPolyMulMod(F, out, dout, table[window / 2], dtable[window / 2], f, df, aux, out);
+        }
+        else{
+
+            for(int k = 0; k <= dtable[window / 2]; k++) out[k] = table[window / 2][k];
+
+            dout = dtable[window / 2];
+            started = 1;
+        }
+
+        i = j - 1;
+    }
+
+    if(dout >= df) dout = gfPolyDivRem(F, out, dout, f, df, NULL);
+
+    for(int i = 0; i < half; i++) free(table[i]);
+
+    free(table);
+    free(dtable);
+    free(sq);
+    free(aux);
+
+    return dout;
+}
+
+//-----------------------------------------------------------------------------
+
+int gfPolyGcd(const gfField* F, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* g){
+
+    int size = ((da > db) ? da : db) + 1;
+    unsigned long long *u = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *v = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+
+    if(u == NULL || v == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) u[i] = a[i];
+    for(int i = 0; i <= db; i++) v[i] = b[i];
+
+    da = mpTrim(u, da);
+    db = mpTrim(v, db);
+
+    while(db >= 0){
+
+        int dr = gfPolyDivRem(F, u, da, v, db, NULL);
+        unsigned long long *t = u;
+
+        u = v;
+        v = t;
+        da = db;
+        db = dr;
+    }
+
+    if(da >= 0){
+
+        unsigned long long inv = gfPowMod(F, u[da], F->p - 2);
+
+        for(int i = 0; i <= da; i++) g[i] = gfMulMod(F, u[i], inv);
+    }
+
+    free(u);
+    free(v);
+
+    return da;
+}
+
+//-----------------------------------------------------------------------------
+
+int gfEqualDegree(const gfField* F, const unsigned long long* g, int dg, int d, unsigned long long** factors, int* degs, int count){
+
+    if(dg == d){
+
+        factors[count] = (unsigned long long*)malloc((dg + 1) * sizeof(unsigned long long));
+
+        if(factors[count] == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for(int i = 0; i <= dg; i++) factors[count][i] = g[i];
+
+        degs[count] = dg;
+
+        return count + 1;
+    }
+
+    unsigned long long *a = (unsigned long long*)calloc(2 * dg + 1, sizeof(unsigned long long));
+    unsigned long long *u = (unsigned long long*)calloc(2 * dg + 1, sizeof(unsigned long long));
+    unsigned long long *w = (unsigned long long*)calloc(2 * dg + 1, sizeof(unsigned long long));
+    unsigned long long *e = (unsigned long long*)calloc(2 * dg + 1, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * dg + 1, sizeof(unsigned long long));
+
+    if(a == NULL || u == NULL || w == NULL || e == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    while(1){
+
+        for(int i = 0; i < dg; i++) a[i] = mpRandom() % F->p;
+
+        int da = mpTrim(a, dg - 1);
+
+        if(da <= 0) continue;
+
+        int du = da, dw = da;
+
+        for(int i = 0; i <= da; i++) u[i] = w[i] = a[i];
+
+        for(int j = 1; j < d; j++){
+
+            if(F->p == 2){
+
+                du = gfPolyMulMod(F, u, du, u, du, g, dg, aux, u);
+
+                for(int i = 0; i <= ((dw > du) ? dw : du); i++){
+
+                    w[i] = gfAddMod(F, (i <= dw) ? w[i] : 0, (i <= du) ? u[i] : 0);
+                }
+
+                dw = mpTrim(w, (dw > du) ? dw : du);
+            }
+            else{
+
+                du = gfPolyPowMod(F, u, du, F->p, g, dg, u);
+                dw = gfPolyMulMod(F, w, dw, u, du, g, dg, aux, w);
+            }
+        }
+
+        if(F->p != 2){
+
+            dw = gfPolyPowMod(F, w, dw, (F->p - 1) / 2, g, dg, w);
+
+            if(dw < 0){
+
+                w[0] = 0;
+                dw = 0;
+            }
+
+            w[0] = gfSubMod(F, w[0], F->one);
+            dw = mpTrim(w, dw);
+        }
+
+        int de = gfPolyGcd(F, w, dw, g, dg, e);
+
+        if(de > 0 && de < dg){
+
+            for(int i = 0; i <= dg; i++) aux[i] = g[i];
+
+            gfPolyDivRem(F, aux, dg, e, de, w);
+
+            count = gfEqualDegree(F, e, de, d, factors, degs, count);
+            count = gfEqualDegree(F, w, dg - de, d, factors, degs, count);
+            break;
+        }
+    }
+
+    free(a);
+    free(u);
+    free(w);
+    free(e);
+    free(aux);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+
+int gfDistinctDegree(const gfField* F, const unsigned long long* f, int df, unsigned long long** factors, int* degs, int count){
+
+    unsigned long long *g = (unsigned long long*)calloc(2 * df + 2, sizeof(unsigned long long));
+    unsigned long long *h = (unsigned long long*)calloc(2 * df + 2, sizeof(unsigned long long));
+    unsigned long long *w = (unsigned long long*)calloc(2 * df + 2, sizeof(unsigned long long));
+    unsigned long long *e = (unsigned long long*)calloc(2 * df + 2, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * df + 2, sizeof(unsigned long long));
+
+    if(g == NULL || h == NULL || w == NULL || e == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int dg = df;
+
+    for(int i = 0; i <= df; i++) g[i] = f[i];
+
+    h[1] = F->one;
+
+    int dh = gfPolyDivRem(F, h, 1, g, dg, NULL);
+
+    for(int i = 1; 2 * i <= dg; i++){
+
+        dh = gfPolyPowMod(F, h, dh, F->p, g, dg, h);
+
+        for(int j = 0; j <= ((dh > 1) ? dh : 1); j++) w[j] = (j <= dh) ? h[j] : 0;
+
+        w[1] = gfSubMod(F, w[1], F->one);
+
+        int dw = mpTrim(w, (dh > 1) ? dh : 1);
+        int de = (dw < 0) ? dg : gfPolyGcd(F, w, dw, g, dg, e);
+
+        if(dw < 0){
+
+            for(int j = 0; j <= dg; j++) e[j] = g[j];
+        }
+
+        if(de > 0){
+
+            count = gfEqualDegree(F, e, de, i, factors, degs, count);
+
+            for(int j = 0; j <= dg; j++) aux[j] = g[j];
+
+            gfPolyDivRem(F, aux, dg, e, de, g);
+            dg -= de;
+
+            if(dg > 0) dh = gfPolyDivRem(F, h, dh, g, dg, NULL);
+        }
+    }
+
+    if(dg > 0) count = gfEqualDegree(F, g, dg, dg, factors, degs, count);
+
+    free(g);
+    free(h);
+    free(w);
+    free(e);
+    free(aux);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpGfPoly(const void* a, const void* b){
+
+    const gfPolynomial *x = (const gfPolynomial*)a, *y = (const gfPolynomial*)b;
+
+    if(x->degree != y->degree) return (x->degree > y->degree) - (x->degree < y->degree);
+
+    for(int i = x->degree; i >= 0; i--){
+
+        if(x->coef[i] != y->coef[i]) return (x->coef[i] > y->coef[i]) - (x->coef[i] < y->coef[i]);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpUll(const void* a, const void* b){
+
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+
+    return (x > y) - (x < y);
+}
+
+//-----------------------------------------------------------------------------
+
+gfPolynomial gfCreate(int degree, unsigned long long p){
+
+    gfPolynomial f;
+
+    f.p = p;
+    f.degree = degree;
+    f.coef = (unsigned long long*)calloc((degree >= 0) ? degree + 1 : 1, sizeof(unsigned long long));
+
+    if(f.coef == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    return f;
+}
+
+//-----------------------------------------------------------------------------
+
+gfPolynomial gfFromPoly(polynomial p, unsigned long long prime){
+
+    int deg = 0;
+
+    for(int i = 0; i < p.numTerms; i++) deg = (p.terms[i].exponent > deg) ? p.terms[i].exponent : deg;
+
+    gfPolynomial f = gfCreate(deg, prime);
+
+    for(int i = 0; i < p.numTerms; i++){
+
+        long long c = p.terms[i].coefficient % (long long)prime;
+
+        if(p.terms[i].big != NULL){
+
+            c = (long long)bigModSmall(p.terms[i].big, prime);
+
+            if(p.terms[i].big->sign < 0) c = -c;
+        }
+
+        f.coef[p.terms[i].exponent] = (f.coef[p.terms[i].exponent] + (unsigned long long)((c < 0) ? c + (long long)prime : c)) % prime;
+    }
+
+    f.degree = mpTrim(f.coef, deg);
+
+    return f;
+}
+
+//-----------------------------------------------------------------------------
+
+void qFree(qPolynomial q){
+
+    termsFree(q.num.terms, q.num.numTerms);
+    free(q.den);
+}
+
+//-----------------------------------------------------------------------------
+
+void pTreeFree(subproductTree t){
+
+    for(int k = 0; k < t.numPrimes; k++){
+
+        for(int i = 0; i < 2 * t.numNodes; i++) free(t.node[k][i]);
+
+        free(t.node[k]);
+    }
+
+    if(t.weight != NULL) bigsFree(t.weight, t.numPoints);
+
+    bigFree(&t.scale);
+    free(t.modulus);
+    free(t.root);
+    free(t.node);
+    free(t.points);
+}
+
+//-----------------------------------------------------------------------------
+
+void gfFree(gfPolynomial f){
+
+    free(f.coef);
+}
+
+//-----------------------------------------------------------------------------
+
+void gfPrint(gfPolynomial f){
+
+    if(f.degree < 0){
+
+        printf("0");
+        return;
+    }
+
+    printf("%llu%c^%i", f.coef[f.degree], var, f.degree);
+
+    for(int i = f.degree - 1; i >= 0; i--){
+
+        if(f.coef[i] != 0) printf(" + %llu%c^%i", f.coef[i], var, i);
+    }
+
+    printf(" (mod %llu)", f.p);
+}
+
+//-----------------------------------------------------------------------------
+
+gfPolynomial* gfFactor(gfPolynomial f, int* numFactors){
+
+    gfField F = gfInit(f.p);
+    int df = mpTrim(f.coef, f.degree);
+    int size = (df > 0) ? df : 1;
+    gfPolynomial *result = (gfPolynomial*)malloc(size * sizeof(gfPolynomial));
+    unsigned long long **factors = (unsigned long long**)malloc(size * sizeof(unsigned long long*));
+    int *degs = (int*)malloc(size * sizeof(int));
+    unsigned long long *cur = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *c = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *w = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *y = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *z = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+
+    if(result == NULL || factors == NULL || degs == NULL || cur == NULL || c == NULL || w == NULL || y == NULL || z == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    *numFactors = 0;
+
+    int dcur = df;
+    unsigned long long multBase = 1;
+
+    for(int i = 0; i <= df; i++) cur[i] = gfToMont(&F, f.coef[i]);
+
+    if(df > 0){
+
+        unsigned long long inv = gfPowMod(&F, cur[df], f.p - 2);
+
+        for(int i = 0; i <= df; i++) cur[i] = gfMulMod(&F, cur[i], inv);
+    }
+
+    while(dcur > 0){
+
+        for(int i = 1; i <= dcur; i++) w[i-1] = gfMulMod(&F, gfToMont(&F, (unsigned long long)i), cur[i]);
+
+        int dw = mpTrim(w, dcur - 1);
+        int dc = gfPolyGcd(&F, cur, dcur, w, dw, c);
+
+        for(int i = 0; i <= dcur; i++) y[i] = cur[i];
+
+        gfPolyDivRem(&F, y, dcur, c, dc, w);
+        dw = dcur - dc;
+
+        for(unsigned long long mult = multBase; dw > 0; mult += multBase){
+
+            int dy = gfPolyGcd(&F, w, dw, c, dc, y);
+
+            for(int i = 0; i <= dw; i++) z[i] = w[i];
+
+            gfPolyDivRem(&F, z, dw, y, dy, w);
+
+            int dz = dw - dy;
+
+            if(dz > 0){
+
+                int first = *numFactors;
+                int count = gfDistinctDegree(&F, w, dz, factors, degs, first);
+
+                for(int k = first; k < count; k++){
+
+                    for(unsigned long long m = 0; m < mult; m++){
+
+                        result[*numFactors] = gfCreate(degs[k], f.p);
+
+                        for(int i = 0; i <= degs[k]; i++) result[*numFactors].coef[i] = gfFromMont(&F, factors[k][i]);
+
+                        (*numFactors)++;
+                    }
+
+                    free(factors[k]);
+                }
+            }
+
+            for(int i = 0; i <= dy; i++) w[i] = y[i];
+
+            dw = dy;
+
+            for(int i = 0; i <= dc; i++) z[i] = c[i];
+
+            gfPolyDivRem(&F, z, dc, y, dy, c);
+            dc -= dy;
+        }
+
+        if(dc <= 0) break;
+
+        dcur = dc / (int)f.p;
+
+        for(int i = 0; i <= dcur; i++) cur[i] = c[i * (int)f.p];
+
+        multBase *= f.p;
+    }
+
+    qsort(result, *numFactors, sizeof(gfPolynomial), cmpGfPoly);
+
+    free(factors);
+    free(degs);
+    free(cur);
+    free(c);
+    free(w);
+    free(y);
+    free(z);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long* gfRoots(gfPolynomial f, int* numRoots){
+
+    gfField F = gfInit(f.p);
+    int df = mpTrim(f.coef, f.degree);
+    int size = (df > 0) ? df : 1;
+    unsigned long long *roots = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    unsigned long long **factors = (unsigned long long**)malloc(size * sizeof(unsigned long long*));
+    int *degs = (int*)malloc(size * sizeof(int));
+    unsigned long long *g = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *h = (unsigned long long*)calloc(2 * size + 2, sizeof(unsigned long long));
+    unsigned long long *x = (unsigned long long*)calloc(2, sizeof(unsigned long long));
+
+    if(roots == NULL || factors == NULL || degs == NULL || g == NULL || h == NULL || x == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    *numRoots = 0;
+
+    if(df > 0){
+
+        for(int i = 0; i <= df; i++) g[i] = gfToMont(&F, f.coef[i]);
+
+        x[1] = F.one;
+
+        int dh = gfPolyPowMod(&F, x, 1, f.p, g, df, h);
+
+        for(int i = dh + 1; i <= 1; i++) h[i] = 0;
+
+        h[1] = gfSubMod(&F, h[1], F.one);
+        dh = mpTrim(h, (dh > 1) ? dh : 1);
+
+        int dr = (dh < 0) ? gfPolyGcd(&F, g, df, h, -1, h) : gfPolyGcd(&F, h, dh, g, df, h);
+
+        if(dr > 0) *numRoots = gfEqualDegree(&F, h, dr, 1, factors, degs, 0);
+
+        for(int i = 0; i < *numRoots; i++){
+
+            roots[i] = gfFromMont(&F, gfSubMod(&F, 0, factors[i][0]));
+            free(factors[i]);
+        }
+
+        qsort(roots, *numRoots, sizeof(unsigned long long), cmpUll);
+    }
+
+    free(factors);
+    free(degs);
+    free(g);
+    free(h);
+    free(x);
+
+    return roots;
+}
+
+//-----------------------------------------------------------------------------
+
+void henselLift(const unsigned long long* F, int dF, unsigned long long* G, int dG, unsigned long long* H, int dH, unsigned long long p, unsigned long long M){
+
+    int size = 2 * dF + 2;
+    unsigned long long *g0 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *h0 = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *s = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *t = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *e = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *dg = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *dh = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(size, sizeof(unsigned long long));
+
+    if(g0 == NULL || h0 == NULL || s == NULL || t == NULL || e == NULL || dg == NULL || dh == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= dG; i++) g0[i] = G[i] % p;
+    for(int i = 0; i <= dH; i++) h0[i] = H[i] % p;
+
+    mpExtGcd(g0, dG, h0, dH, p, s, t);
+
+    for(unsigned long long m = p; m < M; m *= p){
+
+        unsigned long long mp = m * p;
+
+        mpMul(G, dG, H, dH, mp, aux);
+
+        for(int i = 0; i <= dF; i++){
+
+            e[i] = ((F[i] % mp) + mp - aux[i]) % mp / m;
+        }
+
+        int de = mpTrim(e, dF);
+
+        if(de < 0) continue;
+
+        int dt = mpMul(t, mpTrim(t, dG), e, de, p, aux);
+        int ddg = mpDivRem(aux, dt, g0, dG, p, NULL);
+
+        for(int i = 0; i <= ddg; i++) dg[i] = aux[i];
+
+        int dn = mpMul(h0, dH, dg, ddg, p, aux);
+
+        for(int i = 0; i <= ((de > dn) ? de : dn); i++){
+
+            unsigned long long x = (i <= de) ? e[i] : 0, y = (i <= dn) ? aux[i] : 0;
+
+            e[i] = (x + p - y) % p;
+        }
+
+        de = mpTrim(e, (de > dn) ? de : dn);
+
+        for(int i = 0; i <= dH; i++) dh[i] = 0;
+
+        if(de >= dG) mpDivRem(e, de, g0, dG, p, dh);
+
+        for(int i = 0; i <= ddg; i++) G[i] = (G[i] + mulMod(m, dg[i], mp)) % mp;
+        for(int i = 0; i < dH; i++) H[i] = (H[i] + mulMod(m, dh[i], mp)) % mp;
+    }
+
+    free(g0);
+    free(h0);
+    free(s);
+    free(t);
+    free(e);
+    free(dg);
+    free(dh);
+    free(aux);
+}
+
+//-----------------------------------------------------------------------------
+
+void henselMulti(const unsigned long long* F, int dF, unsigned long long** factors, int* degs, int lo, int hi, unsigned long long p, unsigned long long M){
+
+    if(hi - lo == 1){
+
+        for(int i = 0; i <= dF; i++) factors[lo][i] = F[i];
+
+        return;
+    }
+
+    int mid = (lo + hi) / 2, dG = 0, dH = 0;
+    unsigned long long *G = (unsigned long long*)calloc(2 * dF + 2, sizeof(unsigned long long));
+    unsigned long long *H = (unsigned long long*)calloc(2 * dF + 2, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * dF + 2, sizeof(unsigned long long));
+
+    if(G == NULL || H == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    G[0] = H[0] = 1;
+
+    for(int i = lo; i < hi; i++){
+
+        unsigned long long *target = (i < mid) ? G : H;
+        int *dt = (i < mid) ? &dG : &dH;
+
+        *dt = mpMul(target, *dt, factors[i], degs[i], p, aux);
+
+        for(int j = 0; j <= *dt; j++) target[j] = aux[j];
+    }
+
+    henselLift(F, dF, G, dG, H, dH, p, M);
+    henselMulti(G, dG, factors, degs, lo, mid, p, M);
+    henselMulti(H, dH, factors, degs, mid, hi, p, M);
+
+    free(G);
+    free(H);
+    free(aux);
+}
+
+//-----------------------------------------------------------------------------
+
+int zpGcdHeu(const long long* a, int da, const long long* b, int db, long long* g){
+
+    long long normA = 0, normB = 0;
+
+    for(int i = 0; i <= da; i++) normA = (llabs(a[i]) > normA) ? llabs(a[i]) : normA;
+    for(int i = 0; i <= db; i++) normB = (llabs(b[i]) > normB) ? llabs(b[i]) : normB;
+
+    long long xi = 2 * ((normA < normB) ? normA : normB) + 2;
+    int maxDeg = (da > db) ? da : db;
+    long long *h = (long long*)calloc(maxDeg + 2, sizeof(long long));
+    long long *q = (long long*)calloc(maxDeg + 1, sizeof(long long));
+
+    if(h == NULL || q == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int attempt = 0; attempt < GCDHEU_ATTEMPTS; attempt++){
+
+        if((maxDeg + 1) * log2((double)xi) + log2((double)((normA > normB) ? normA : normB) + 1) > 120) break;
+
+        __int128 alpha = 0, beta = 0;
+
+        for(int i = da; i >= 0; i--) alpha = alpha * xi + a[i];
+        for(int i = db; i >= 0; i--) beta = beta * xi + b[i];
+
+        unsigned __int128 x = (alpha < 0) ? -alpha : alpha, y = (beta < 0) ? -beta : beta;
+
+        while(y != 0){
+
+            unsigned __int128 t = x % y;
+
+            x = y;
+            y = t;
+        }
+
+        __int128 gamma = x;
+        int dh = -1;
+
+        while(gamma != 0 && dh < maxDeg + 1){
+
+            __int128 digit = gamma % xi;
+
+            if(digit < 0) digit += xi;
+            if(digit > xi / 2) digit -= xi;
+
+            h[++dh] = (long long)digit;
+            gamma = (gamma - digit) / xi;
+        }
+
+        if(gamma == 0 && dh >= 0){
+
+            zpPrimitive(h, dh);
+
+            if(dh <= da && dh <= db && zpDivExact(a, da, h, dh, q) && zpDivExact(b, db, h, dh, q)){
+
+                for(int i = 0; i <= dh; i++) g[i] = h[i];
+
+                free(h);
+                free(q);
+
+                return dh;
+            }
+        }
+
+        xi = (long long)((__int128)xi * 73794 / 27011);
+    }
+
+    free(h);
+    free(q);
+
+    return -2;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpGcdModular(const long long* a, int da, const long long* b, int db, long long* g){
+
+    int maxDeg = (da > db) ? da : db;
+    unsigned long long lcGcd = ullGcd((unsigned long long)llabs(a[da]), (unsigned long long)llabs(b[db]));
+    unsigned long long *ap = (unsigned long long*)malloc((maxDeg + 1) * sizeof(unsigned long long));
+    unsigned long long *bp = (unsigned long long*)malloc((maxDeg + 1) * sizeof(unsigned long long));
+    unsigned long long *gp = (unsigned long long*)malloc((maxDeg + 1) * sizeof(unsigned long long));
+    unsigned __int128 *crt = (unsigned __int128*)malloc((maxDeg + 1) * sizeof(unsigned __int128));
+    long long *h = (long long*)malloc((maxDeg + 1) * sizeof(long long));
+    long long *q = (long long*)malloc((maxDeg + 1) * sizeof(long long));
+
+    if(ap == NULL || bp == NULL || gp == NULL || crt == NULL || h == NULL || q == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    unsigned __int128 modulus = 0;
+    int dg = maxDeg + 1, result = -2;
+
+    for(unsigned long long p = GCD_PRIME_START; p > 2 && result == -2; p -= 2){
+
+        if(!isPrime(p) || a[da] % (long long)p == 0 || b[db] % (long long)p == 0) continue;
+
+        for(int i = 0; i <= da; i++) ap[i] = (unsigned long long)(a[i] % (long long)p + (long long)p) % p;
+        for(int i = 0; i <= db; i++) bp[i] = (unsigned long long)(b[i] % (long long)p + (long long)p) % p;
+
+        int dp = mpGcd(ap, da, bp, db, p, gp);
+
+        if(dp == 0){
+
+            g[0] = 1;
+            result = 0;
+            break;
+        }
+
+        if(dp > dg) continue;
+
+        for(int i = 0; i <= dp; i++) gp[i] = mulMod(gp[i], lcGcd % p, p);
+
+        if(dp < dg){
+
+            dg = dp;
+            modulus = p;
+
+            for(int i = 0; i <= dg; i++) crt[i] = gp[i];
+        }
+        else{
+
+            unsigned long long mInv = mpInv((unsigned long long)(modulus % p), p);
+
+            for(int i = 0; i <= dg; i++){
+
+                unsigned long long diff = (gp[i] + p - (unsigned long long)(crt[i] % p)) % p;
+
+                crt[i] += modulus * mulMod(diff, mInv, p);
+            }
+
+            modulus *= p;
+        }
+
+        int fits = 1;
+
+        for(int i = 0; i <= dg && fits; i++){
+
+            __int128 c = (crt[i] > modulus / 2) ? -(__int128)(modulus - crt[i]) : (__int128)crt[i];
+
+            if(c > LLONG_MAX / 4 || c < -(LLONG_MAX / 4)) fits = 0;
+            else h[i] = (long long)c;
+        }
+
+        if(fits){
+
+            zpPrimitive(h, dg);
+
+            if(zpDivExact(a, da, h, dg, q) && zpDivExact(b, db, h, dg, q)){
+
+                for(int i = 0; i <= dg; i++) g[i] = h[i];
+
+                result = dg;
+            }
+        }
+
+        if(result == -2 && modulus > ((unsigned __int128)1 << 94)) break;
+    }
+
+    free(ap);
+    free(bp);
+    free(gp);
+    free(crt);
+    free(h);
+    free(q);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpGcd(const long long* a, int da, const long long* b, int db, long long* g){
+
+    int size = ((da > db) ? da : db) + 1;
+
+    if(da < 0 || db < 0) return zpGcdPrs(a, da, b, db, g);
+
+    long long *u = (long long*)malloc(size * sizeof(long long));
+    long long *v = (long long*)malloc(size * sizeof(long long));
+
+    if(u == NULL || v == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) u[i] = a[i];
+    for(int i = 0; i <= db; i++) v[i] = b[i];
+
+    zpPrimitive(u, da);
+    zpPrimitive(v, db);
+
+    int dg = -2;
+
+    if(da == 0 || db == 0){
+
+        g[0] = 1;
+        dg = 0;
+    }
+
+    if(dg == -2 && ((da > db) ? da : db) <= GCDHEU_MAX_DEGREE) dg = zpGcdHeu(u, da, v, db, g);
+    if(dg == -2) dg = zpGcdModular(u, da, v, db, g);
+    if(dg == -2) dg = zpGcdPrs(u, da, v, db, g);
+
+    free(u);
+    free(v);
+
+    return dg;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pGcd(polynomial a, polynomial b){
+
+    int da = 0, db = 0;
+    long long *ca = zpFromPoly(a, &da);
+    long long *cb = zpFromPoly(b, &db);
+    int dg = -2;
+
+    if(ca != NULL && cb != NULL){
+
+        long long *g = (long long*)calloc(((da > db) ? da : db) + 2, sizeof(long long));
+
+        if(g == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        long long content = (long long)ullGcd((unsigned long long)zpContent(ca, da), (unsigned long long)zpContent(cb, db));
+
+        dg = zpGcd(ca, da, cb, db, g);
+
+        if(dg == -1){
+
+            dg = 0;
+            g[0] = 0;
+        }
+
+        if(dg >= 0){
+
+            polynomial result = pCreate(dg + 1);
+
+            for(int i = 0; i <= dg; i++) result.terms[dg - i] = termFromInt128((__int128)g[i] * ((content == 0) ? 1 : content), i);
+
+            free(ca);
+            free(cb);
+            free(g);
+
+            return result;
+        }
+
+        free(g);
+    }
+
+    free(ca);
+    free(cb);
+
+    // heap coefficients, or every word-size method overflowed: the gcd is
+    // taken with multi-limb coefficients, so the result is always exact
+    int m = 0, n = 0;
+    bigInt *A = bigsFromPoly(a, &m);
+    bigInt *B = bigsFromPoly(b, &n);
+    bigInt c;
+
+    if(m < n){
+
+        bigInt *t = A;
+        int dt = m;
+
+        A = B;
+        B = t;
+        m = n;
+        n = dt;
+    }
+
+    bigInt *G = (bigInt*)malloc((m + 1) * sizeof(bigInt));
+
+    if(G == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&c, 0);
+
+    for(int i = 0; i <= m; i++) bigGcd(&c, &A[i], &c);
+    for(int i = 0; i <= n; i++) bigGcd(&c, &B[i], &c);
+
+    dg = bigPolyGcd(A, m, B, n, G);
+
+    for(int i = 0; i <= dg; i++) bigMul(&G[i], &c);
+
+    bigFree(&c);
+    bigsFree(A, m + 1);
+    bigsFree(B, n + 1);
+
+    return bigsToPoly(G, dg);
+}
+
+//-----------------------------------------------------------------------------
+
+void cyclotomicFac(polynomial p) {
+
+    int grau = p.terms[0].exponent;
+    int count = 0;
+    int *orders = cyclotomicCandidates(grau, &count);
+    int *mult = (int*)malloc(count * sizeof(int));
+    long long *rest = (long long*)malloc((grau + 1) * sizeof(long long));
+
+    if(mult == NULL || rest == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int found = cyclotomicOrders(p, orders, count, mult, rest);
+
+    if(found > 0){
+
+        int maxMult = 0;
+
+        for(int k = 0; k < count; k++) maxMult = (mult[k] > maxMult) ? mult[k] : maxMult;
+
+        for(int m = 1; m <= maxMult; m++){
+
+            int groupDeg = 0;
+
+            for(int k = 0; k < count; k++) groupDeg += (mult[k] == m) ? totient(orders[k]) : 0;
+
+            if(groupDeg == 0) continue;
+
+            if(m > 1 && groupDeg > 1) printf("(");
+
+            printUnityRoots(orders, mult, count, m);
+
+            if(m > 1 && groupDeg > 1) printf(")");
+            if(m > 1) printf("^%d", m);
+        }
+    }
+
+    if(found < 0) squareFreeFac(p, 1);
+    else if(found < grau){
+
+        polynomial cofactor = zpToPoly(rest, grau - found);
+
+        squareFreeFac(cofactor, 1);
+        termsFree(cofactor.terms, cofactor.numTerms);
+    }
+
+    free(orders);
+    free(mult);
+    free(rest);
+}
+
+//-----------------------------------------------------------------------------
+
+void binomialFac(polynomial p) {
+
+    if (pHasBig(p)) {
+
+        aberth(p);
+        return;
+    }
+
+    int n = 0;
+    int k = 1;
+    long long lead = 0, constant = 0, u = 0, v = 0;
+    char radius[64];
+    char scale[72];
+    char imaginary[80];
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        if (p.terms[i].coefficient == 0) continue;
+
+        if (p.terms[i].exponent > 0) {
+
+            n = p.terms[i].exponent;
+            lead = p.terms[i].coefficient;
+        }
+        else constant = p.terms[i].coefficient;
+    }
+
+    // x^n = -constant / lead, whose real n-th root is Surd[u/v, n / k] once
+    // u^k and v^k are taken out of |constant| and lead
+    int negative = (constant > 0) != (lead < 0);
+    long long top = llabs(constant), bottom = llabs(lead);
+
+    u = top;
+    v = bottom;
+
+    if (top == 1 && bottom == 1) k = n;
+
+    for (int d = (n < 62) ? n : 62; d > 1 && k == 1; d--) {
+
+        if (n % d == 0 && perfectPower(top, d, &u) && perfectPower(bottom, d, &v)) k = d;
+        else {
+
+            u = top;
+            v = bottom;
+        }
+    }
+
+    int index = n / k;
+
+    if (index == 1 && v == 1) snprintf(radius, sizeof(radius), "%lld", u);
+    else if (index == 1) snprintf(radius, sizeof(radius), "%lld/%lld", u, v);
+    else if (index == 2) {
+
+        // Sqrt[u/v] = s Sqrt[r] / v with r square-free, over the lowest terms
+        long long zero = 0, den = v, radicand = u * v;
+        long long s = surdReduce(&zero, &den, &radicand);
+        int len = (s == 1) ? 0 : snprintf(radius, sizeof(radius), "%lld", s);
+
+        if (den == 1) snprintf(radius + len, sizeof(radius) - len, "Sqrt[%lld]", radicand);
+        else snprintf(radius + len, sizeof(radius) - len, "Sqrt[%lld]/%lld", radicand, den);
+    }
+    else if (v == 1) snprintf(radius, sizeof(radius), "Surd[%lld, %d]", u, index);
+    else snprintf(radius, sizeof(radius), "Surd[%lld/%lld, %d]", u, v, index);
+
+    if (u == 1 && v == 1) scale[0] = '\0';
+    else snprintf(scale, sizeof(scale), "%s*", radius);
+
+    if (index == 1 && v == 1) snprintf(imaginary, sizeof(imaginary), "%si", (u == 1) ? "" : radius);
+    else snprintf(imaginary, sizeof(imaginary), "%si", scale);
+
+    if (!negative) printf("(%c - %s)", var, radius);
+    if (n % 2 == negative) printf("(%c + %s)", var, radius);
+
+    // Roots radius * Exp[±t*i*Pi/n], t even for a positive right-hand side and
+    // odd for a negative one, printed in increasing angle without storing them
+    for (int t = negative ? 1 : 2; t < n; t += 2) {
+
+        int divisor = gcd(t, n);
+        int num = t / divisor;
+        int den = n / divisor;
+
+        if (den == 2) {
+
+            // Exp[±i*Pi/2] = ±i
+            printf("(%c - %s)", var, imaginary);
+            printf("(%c + %s)", var, imaginary);
+        }
+        else if (num == 1) {
+
+            printf("(%c - %sExp[i*Pi/%d])", var, scale, den);
+            printf("(%c - %sExp[-i*Pi/%d])", var, scale, den);
+        }
+        else {
+
+            printf("(%c - %sExp[%d*i*Pi/%d])", var, scale, num, den);
+            printf("(%c - %sExp[-%d*i*Pi/%d])", var, scale, num, den);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int perfectPower(long long x, int k, long long* root){
+
+    if (x == 1) {
+
+        *root = 1;
+        return 1;
+    }
+
+    long long guess = llround(nrt((double)x, k));
+
+    for (long long c = (guess > 2) ? guess - 1 : 2; c <= guess + 1; c++) {
+
+        long long value = 1;
+        int over = 0;
+
+        for (int i = 0; i < k && !over; i++) {
+
+            if (__builtin_mul_overflow(value, c, &value) || value > x) over = 1;
+        }
+
+        if (!over && value == x) {
+
+            *root = c;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+int totient(int n){
+
+    unsigned long long primes[16];
+    int mult[16];
+    int numPrimes = factorInt(n, primes, mult);
+    int phi = n;
+
+    for(int i = 0; i < numPrimes; i++) phi = phi / (int)primes[i] * ((int)primes[i] - 1);
+
+    return phi;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpMulMod(const long long* a, int da, const long long* b, int db, const long long* f, int df, long long* out){
+
+    if(da < 0 || db < 0) return -1;
+
+    long long *t = (long long*)calloc(da + db + 1, sizeof(long long));
+
+    if(t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int overflow = 0;
+
+    for(int i = 0; i <= da && !overflow; i++){
+
+        for(int j = 0; j <= db && !overflow; j++){
+
+            long long prod;
+
+            overflow = __builtin_mul_overflow(a[i], b[j], &prod) || __builtin_add_overflow(t[i+j], prod, &t[i+j]);
+        }
+    }
+
+    for(int k = da + db; k >= df && !overflow; k--){
+
+        long long q = t[k] * f[df];
+
+        for(int j = 0; j <= df && !overflow; j++){
+
+            long long prod;
+
+            overflow = __builtin_mul_overflow(q, f[j], &prod) || __builtin_sub_overflow(t[k-df+j], prod, &t[k-df+j]);
+        }
+    }
+
+    int dout = -2;
+
+    if(!overflow){
+
+        int top = (da + db < df - 1) ? da + db : df - 1;
+
+        for(int i = 0; i <= top; i++) out[i] = t[i];
+
+        dout = zpTrim(out, top);
+    }
+
+    free(t);
+
+    return dout;
+}
+
+//-----------------------------------------------------------------------------
+
+long long* cyclotomicBuild(int n){
+
+    unsigned long long primes[16];
+    int mult[16];
+    int numPrimes = factorInt(n, primes, mult);
+    int oddPrimes[16];
+    int numOdd = 0;
+    int odd = 1;
+    int even = (n % 2 == 0);
+
+    for(int i = 0; i < numPrimes; i++){
+
+        if(primes[i] == 2) continue;
+
+        oddPrimes[numOdd++] = (int)primes[i];
+        odd *= (int)primes[i];
+    }
+
+    int stretch = n / (even ? 2 * odd : odd);
+    int deg = totient(odd);
+    long long *base = (long long*)calloc(deg + 1, sizeof(long long));
+    long long *phi = (long long*)calloc(deg * stretch + 2, sizeof(long long));
+
+    if(base == NULL || phi == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    if(odd == 1){
+
+        base[0] = even ? 1 : -1;
+        base[1] = 1;
+    }
+    else{
+
+        base[0] = 1;
+
+        for(int pass = 0; pass < 2; pass++){
+
+            for(int mask = 0; mask < (1 << numOdd); mask++){
+
+                int d = odd;
+
+                for(int i = 0; i < numOdd; i++){
+
+                    if(mask & (1 << i)) d /= oddPrimes[i];
+                }
+
+                if(__builtin_popcount(mask) % 2 != pass) continue;
+
+                if(pass == 0) for(int i = deg; i >= d; i--) base[i] -= base[i-d];
+                else for(int i = d; i <= deg; i++) base[i] += base[i-d];
+            }
+        }
+    }
+
+    if(even && odd > 1){
+
+        for(int i = 1; i <= deg; i += 2) base[i] = -base[i];
+    }
+
+    phi[0] = (long long)deg * stretch;
+
+    for(int i = 0; i <= deg; i++) phi[1 + i * stretch] = base[i];
+
+    free(base);
+
+    return phi;
+}
+
+//-----------------------------------------------------------------------------
+
+const long long* cyclotomicCached(int n){
+
+    static long long** blocks[CYCLOTOMIC_ORDER_LIMIT / CYCLOTOMIC_CACHE_BLOCK];
+
+    if(n < 1 || n >= CYCLOTOMIC_ORDER_LIMIT) return NULL;
+
+    long long ***slot = &blocks[n / CYCLOTOMIC_CACHE_BLOCK];
+    long long **block = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+
+    if(block == NULL){
+
+        long long **fresh = (long long**)calloc(CYCLOTOMIC_CACHE_BLOCK, sizeof(long long*));
+
+        if(fresh == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        if(__atomic_compare_exchange_n(slot, &block, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) block = fresh;
+        else free(fresh);
+    }
+
+    long long **entry = &block[n % CYCLOTOMIC_CACHE_BLOCK];
+    long long *phi = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+
+    if(phi == NULL){
+
+        long long *fresh = cyclotomicBuild(n);
+
+        if(__atomic_compare_exchange_n(entry, &phi, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) phi = fresh;
+        else free(fresh);
+    }
+
+    return phi;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pCyclotomic(int n){
+
+    const long long *phi = cyclotomicCached(n);
+
+    if(phi == NULL) return pCreate(0);
+
+    return zpToPoly(phi + 1, (int)phi[0]);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigInit(bigInt* x, long long v){
+
+    x->cap = 2;
+    x->limb = (unsigned long long*)calloc(x->cap, sizeof(unsigned long long));
+
+    if(x->limb == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    x->sign = (v > 0) - (v < 0);
+    x->limb[0] = (v < 0) ? -(unsigned long long)v : (unsigned long long)v;
+    x->size = (v != 0);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigFree(bigInt* x){
+
+    free(x->limb);
+    x->limb = NULL;
+    x->size = x->cap = x->sign = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigReserve(bigInt* x, int size){
+
+    if(size <= x->cap) return;
+
+    int cap = (2 * x->cap > size) ? 2 * x->cap : size;
+    unsigned long long *limb = (unsigned long long*)realloc(x->limb, cap * sizeof(unsigned long long));
+
+    if(limb == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    x->limb = limb;
+    x->cap = cap;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigAddMul(bigInt* r, const bigInt* a, long long m){
+
+    if(m == 0 || a->sign == 0) return;
+
+    int sa = (m < 0) ? -a->sign : a->sign;
+    unsigned long long um = (m < 0) ? -(unsigned long long)m : (unsigned long long)m;
+    int n = ((a->size > r->size) ? a->size : r->size) + 1;
+
+    bigReserve(r, n);
+
+    for(int i = r->size; i < n; i++) r->limb[i] = 0;
+
+    if(r->sign == 0 || r->sign == sa){
+
+        unsigned __int128 carry = 0;
+
+        for(int i = 0; i < n; i++){
+
+            unsigned __int128 t = carry + r->limb[i];
+
+            if(i < a->size) t += (unsigned __int128)a->limb[i] * um;
+
+            r->limb[i] = (unsigned long long)t;
+            carry = t >> 64;
+        }
+
+        r->sign = sa;
+    }
+    else{
+
+        unsigned long long mulCarry = 0, borrow = 0;
+
+        for(int i = 0; i < n; i++){
+
+            unsigned __int128 t = mulCarry;
+
+            if(i < a->size) t += (unsigned __int128)a->limb[i] * um;
+
+            unsigned long long lo = (unsigned long long)t;
+            unsigned long long x = r->limb[i];
+            unsigned long long d = x - lo;
+            unsigned long long b1 = (x < lo);
+
+            mulCarry = (unsigned long long)(t >> 64);
+            r->limb[i] = d - borrow;
+            borrow = b1 + (d < borrow);
+        }
+
+        // r - a*m went below zero: the magnitude is the two's complement
+        if(borrow){
+
+            unsigned long long carry = 1;
+
+            for(int i = 0; i < n; i++){
+
+                r->limb[i] = ~r->limb[i] + carry;
+                carry = (carry && r->limb[i] == 0);
+            }
+
+            r->sign = sa;
+        }
+    }
+
+    r->size = n;
+
+    while(r->size > 0 && r->limb[r->size - 1] == 0) r->size--;
+
+    if(r->size == 0) r->sign = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigScale(bigInt* x, long long m){
+
+    if(x->sign == 0) return;
+
+    if(m == 0){
+
+        x->size = x->sign = 0;
+        return;
+    }
+
+    unsigned long long um = (m < 0) ? -(unsigned long long)m : (unsigned long long)m;
+    unsigned __int128 carry = 0;
+
+    bigReserve(x, x->size + 1);
+
+    for(int i = 0; i < x->size; i++){
+
+        unsigned __int128 t = (unsigned __int128)x->limb[i] * um + carry;
+
+        x->limb[i] = (unsigned long long)t;
+        carry = t >> 64;
+    }
+
+    if(carry) x->limb[x->size++] = (unsigned long long)carry;
+
+    if(m < 0) x->sign = -x->sign;
+}
+
+//-----------------------------------------------------------------------------
+
+double bigLog2(const bigInt* x){
+
+    if(x->sign == 0) return -HUGE_VAL;
+
+    double top = (double)x->limb[x->size - 1];
+
+    if(x->size > 1) top += (double)x->limb[x->size - 2] / 18446744073709551616.0;
+
+    return log2(top) + 64.0 * (x->size - 1);
+}
+
+//-----------------------------------------------------------------------------
+
+int bigPolySign(const bigInt* c, int deg, long long num, long long den){
+
+    bigInt acc, power;
+
+    // den^deg p(num/den) = sum c_i num^i den^(deg-i), by Horner on num
+    bigInit(&acc, 0);
+    bigAdd(&acc, &c[deg]);
+    bigInit(&power, 1);
+
+    for(int i = deg - 1; i >= 0; i--){
+
+        bigScale(&acc, num);
+        bigScale(&power, den);
+        bigAddProduct(&acc, &power, &c[i]);
+    }
+
+    int sign = acc.sign;
+
+    bigFree(&acc);
+    bigFree(&power);
+
+    return sign;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigAdd(bigInt* r, const bigInt* a){
+
+    if(a->sign == 0) return;
+
+    if(r->sign != 0 && r->sign != a->sign){
+
+        bigAddMul(r, a, 1);
+        return;
+    }
+
+    int n = ((a->size > r->size) ? a->size : r->size) + 1;
+    unsigned long long carry = 0;
+
+    bigReserve(r, n);
+
+    for(int i = r->size; i < n; i++) r->limb[i] = 0;
+
+    for(int i = 0; i < n; i++){
+
+        unsigned long long x = r->limb[i];
+        unsigned long long y = (i < a->size) ? a->limb[i] : 0;
+        unsigned long long s = x + y;
+        unsigned long long c1 = (s < x);
+
+        r->limb[i] = s + carry;
+        carry = c1 + (r->limb[i] < s);
+
+        if(i >= a->size && carry == 0) break;
+    }
+
+    r->sign = a->sign;
+    r->size = n;
+
+    while(r->size > 0 && r->limb[r->size - 1] == 0) r->size--;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigDivSmall(bigInt* x, long long m){
+
+    unsigned long long um = (m < 0) ? -(unsigned long long)m : (unsigned long long)m;
+    unsigned __int128 rem = 0;
+
+    for(int i = x->size - 1; i >= 0; i--){
+
+        unsigned __int128 cur = (rem << 64) | x->limb[i];
+
+        x->limb[i] = (unsigned long long)(cur / um);
+        rem = cur % um;
+    }
+
+    while(x->size > 0 && x->limb[x->size - 1] == 0) x->size--;
+
+    if(x->size == 0) x->sign = 0;
+    else if(m < 0) x->sign = -x->sign;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long bigModSmall(const bigInt* x, unsigned long long m){
+
+    unsigned __int128 rem = 0;
+
+    for(int i = x->size - 1; i >= 0; i--) rem = ((rem << 64) | x->limb[i]) % m;
+
+    return (unsigned long long)rem;
+}
+
+//-----------------------------------------------------------------------------
+
+double bigToDouble(const bigInt* x){
+
+    double v = 0.0;
+    int low = (x->size > 3) ? x->size - 3 : 0;
+
+    for(int i = x->size - 1; i >= low; i--) v = v * 18446744073709551616.0 + (double)x->limb[i];
+
+    return x->sign * ldexp(v, 64 * low);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigPrint(const bigInt* x){
+
+    const unsigned long long base = 1000000000000000000ULL;
+    int count = 0;
+    bigInt t;
+    unsigned long long *chunk = (unsigned long long*)malloc((2 * x->size + 1) * sizeof(unsigned long long));
+
+    if(chunk == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&t, 0);
+    bigAdd(&t, x);
+
+    // 18 decimal digits at a time, least significant first
+    do{
+
+        chunk[count++] = bigModSmall(&t, base);
+        bigDivSmall(&t, (long long)base);
+    } while(t.size > 0);
+
+    if(x->sign < 0) printf("-");
+
+    printf("%llu", chunk[count - 1]);
+
+    for(int i = count - 2; i >= 0; i--) printf("%018llu", chunk[i]);
+
+    bigFree(&t);
+    free(chunk);
+}
+
+//-----------------------------------------------------------------------------
+
+term termFromBig(bigInt* x, int exp){
+
+    term T = setTerms(0, exp);
+
+    if(x->size == 0 || (x->size == 1 && x->limb[0] <= INT_MAX)){
+
+        if(x->size == 1) T.coefficient = x->sign * (int)x->limb[0];
+
+        bigFree(x);
+
+        return T;
+    }
+
+    T.coefficient = (x->sign > 0) ? INT_MAX : INT_MIN;
+    T.big = (bigInt*)malloc(sizeof(bigInt));
+
+    if(T.big == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    *T.big = *x;
+
+    return T;
+}
+
+//-----------------------------------------------------------------------------
+
+void termToBig(term t, bigInt* x){
+
+    bigInit(x, (t.big != NULL) ? 0 : t.coefficient);
+
+    if(t.big != NULL) bigAdd(x, t.big);
+}
+
+//-----------------------------------------------------------------------------
+
+void termAdd(term* t, term a){
+
+    long long sum = (long long)t->coefficient + a.coefficient;
+
+    if(t->big == NULL && a.big == NULL && sum >= -INT_MAX && sum <= INT_MAX){
+
+        t->coefficient = (int)sum;
+        return;
+    }
+
+    bigInt x, y;
+    int exp = t->exponent;
+
+    termToBig(*t, &x);
+    termToBig(a, &y);
+    bigAdd(&x, &y);
+    bigFree(&y);
+    termFree(t);
+
+    *t = termFromBig(&x, exp);
+}
+
+//-----------------------------------------------------------------------------
+
+void termFree(term* t){
+
+    if(t->big == NULL) return;
+
+    bigFree(t->big);
+    free(t->big);
+    t->big = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long limbAddTo(unsigned long long* r, int nr, const unsigned long long* a, int na){
+
+    unsigned long long carry = 0;
+
+    for(int i = 0; i < nr && (i < na || carry); i++){
+
+        unsigned long long y = (i < na) ? a[i] : 0;
+        unsigned long long s = r[i] + y;
+        unsigned long long c1 = (s < y);
+
+        r[i] = s + carry;
+        carry = c1 + (r[i] < s);
+    }
+
+    return carry;
+}
+
+//-----------------------------------------------------------------------------
+
+void limbSubFrom(unsigned long long* r, int nr, const unsigned long long* a, int na){
+
+    unsigned long long borrow = 0;
+
+    for(int i = 0; i < nr && (i < na || borrow); i++){
+
+        unsigned long long y = (i < na) ? a[i] : 0;
+        unsigned long long d = r[i] - y;
+        unsigned long long b1 = (r[i] < y);
+
+        r[i] = d - borrow;
+        borrow = b1 + (d < borrow);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void limbMul(const unsigned long long* a, int na, const unsigned long long* b, int nb, unsigned long long* r){
+
+    if(na < nb){
+
+        const unsigned long long *t = a;
+        int nt = na;
+
+        a = b;
+        na = nb;
+        b = t;
+        nb = nt;
+    }
+
+    for(int i = 0; i < na + nb; i++) r[i] = 0;
+
+    if(nb < KARATSUBA_LIMBS){
+
+        for(int j = 0; j < nb; j++){
+
+            unsigned long long carry = 0;
+
+            if(b[j] == 0) continue;
+
+            for(int i = 0; i < na; i++){
+
+                unsigned __int128 t = (unsigned __int128)a[i] * b[j] + r[i + j] + carry;
+
+                r[i + j] = (unsigned long long)t;
+                carry = (unsigned long long)(t >> 64);
+            }
+
+            r[na + j] = carry;
+        }
+
+        return;
+    }
+
+    unsigned long long *t = (unsigned long long*)malloc(2 * (na + nb + 2) * sizeof(unsigned long long));
+
+    if(t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // Unbalanced operands are cut into nb-limb slices of a
+    if(na >= 2 * nb){
+
+        for(int i = 0; i < na; i += nb){
+
+            int len = (na - i < nb) ? na - i : nb;
+
+            limbMul(a + i, len, b, nb, t);
+            limbAddTo(r + i, na + nb - i, t, len + nb);
+        }
+
+        free(t);
+        return;
+    }
+
+    // (a1 W + a0)(b1 W + b0) = a1b1 W^2 + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) W + a0b0
+    int h = na / 2;
+    int ns = na - h + 1;
+    unsigned long long *sa = (unsigned long long*)calloc(2 * ns, sizeof(unsigned long long));
+    unsigned long long *mid = (unsigned long long*)malloc(2 * ns * sizeof(unsigned long long));
+
+    if(sa == NULL || mid == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    unsigned long long *sb = sa + ns;
+
+    for(int i = 0; i < na - h; i++) sa[i] = a[h + i];
+    for(int i = 0; i < nb - h; i++) sb[i] = b[h + i];
+
+    limbAddTo(sa, ns, a, h);
+    limbAddTo(sb, ns, b, h);
+    limbMul(sa, ns, sb, ns, mid);
+
+    limbMul(a, h, b, h, t);
+    limbSubFrom(mid, 2 * ns, t, 2 * h);
+    limbAddTo(r, na + nb, t, 2 * h);
+
+    limbMul(a + h, na - h, b + h, nb - h, t);
+    limbSubFrom(mid, 2 * ns, t, na + nb - 2 * h);
+    limbAddTo(r + 2 * h, na + nb - 2 * h, t, na + nb - 2 * h);
+
+    limbAddTo(r + h, na + nb - h, mid, (2 * ns < na + nb - h) ? 2 * ns : na + nb - h);
+
+    free(sa);
+    free(mid);
+    free(t);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigPolyMulNonNeg(const bigInt* a, int da, const bigInt* b, int db, bigInt* r){
+
+    int maxA = 1, maxB = 1;
+
+    for(int i = 0; i <= da; i++) maxA = (a[i].size > maxA) ? a[i].size : maxA;
+    for(int i = 0; i <= db; i++) maxB = (b[i].size > maxB) ? b[i].size : maxB;
+
+    // Kronecker substitution x = 2^(64L): one limb of slack absorbs the sum of
+    // up to min(da, db) + 1 products in each digit
+    int L = maxA + maxB + 1;
+    int na = (da + 1) * L, nb = (db + 1) * L;
+    unsigned long long *pa = (unsigned long long*)calloc(na, sizeof(unsigned long long));
+    unsigned long long *pb = (unsigned long long*)calloc(nb, sizeof(unsigned long long));
+    unsigned long long *pr = (unsigned long long*)malloc((na + nb) * sizeof(unsigned long long));
+
+    if(pa == NULL || pb == NULL || pr == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++){
+
+        for(int j = 0; j < a[i].size; j++) pa[i * L + j] = a[i].limb[j];
+    }
+
+    for(int i = 0; i <= db; i++){
+
+        for(int j = 0; j < b[i].size; j++) pb[i * L + j] = b[i].limb[j];
+    }
+
+    limbMul(pa, na, pb, nb, pr);
+
+    for(int k = 0; k <= da + db; k++){
+
+        bigReserve(&r[k], L);
+
+        for(int j = 0; j < L; j++) r[k].limb[j] = pr[k * L + j];
+
+        r[k].size = L;
+
+        while(r[k].size > 0 && r[k].limb[r[k].size - 1] == 0) r[k].size--;
+
+        r[k].sign = (r[k].size > 0);
+    }
+
+    free(pa);
+    free(pb);
+    free(pr);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigTaylorShift(bigInt* c, int deg, long long a){
+
+    if(a == 0 || deg < 1) return;
+
+    // Shifting by one needs only additions, with no limb products
+    for(int i = 0; i < deg; i++){
+
+        for(int j = deg - 1; j >= i; j--){
+
+            if(a == 1) bigAdd(&c[j], &c[j + 1]);
+            else bigAddMul(&c[j], &c[j + 1], a);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pTaylorShift(polynomial p, int a){
+
+    polynomial dense = pDense(p);
+    int n = dense.numTerms - 1;
+    bigInt *c = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+    if(c == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= n; i++){
+
+        termToBig(dense.terms[n - i], &c[i]);
+        termFree(&dense.terms[n - i]);
+    }
+
+    bigTaylorShift(c, n, a);
+
+    for(int i = 0; i <= n; i++) dense.terms[n - i] = termFromBig(&c[i], i);
+
+    free(c);
+
+    return dense;
+}
+
+//-----------------------------------------------------------------------------
+
+term termFromInt128(__int128 v, int exp){
+
+    if(v >= -INT_MAX && v <= INT_MAX) return setTerms((int)v, exp);
+
+    unsigned __int128 u = (v < 0) ? -(unsigned __int128)v : (unsigned __int128)v;
+    bigInt x;
+
+    bigInit(&x, 0);
+    x.limb[0] = (unsigned long long)u;
+    x.limb[1] = (unsigned long long)(u >> 64);
+    x.size = (x.limb[1] != 0) ? 2 : 1;
+    x.sign = (v < 0) ? -1 : 1;
+
+    return termFromBig(&x, exp);
+}
+
+//-----------------------------------------------------------------------------
+
+void termsFree(term* t, int numTerms){
+
+    for(int i = 0; i < numTerms; i++) termFree(&t[i]);
+
+    free(t);
+}
+
+//-----------------------------------------------------------------------------
+
+void zpMulKaratsuba(const long long* a, int na, const long long* b, int nb, __int128* r){
+
+    if(na < nb){
+
+        const long long *t = a;
+        int nt = na;
+
+        a = b;
+        na = nb;
+        b = t;
+        nb = nt;
+    }
+
+    for(int i = 0; i < na + nb - 1; i++) r[i] = 0;
+
+    if(nb < MUL_KARATSUBA_TERMS){
+
+        for(int j = 0; j < nb; j++){
+
+            if(b[j] == 0) continue;
+
+            for(int i = 0; i < na; i++) r[i + j] += (__int128)a[i] * b[j];
+        }
+
+        return;
+    }
+
+    __int128 *t = (__int128*)malloc(2 * (na + nb) * sizeof(__int128));
+
+    if(t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // Unbalanced operands are cut into nb-term slices of a
+    if(na >= 2 * nb){
+
+        for(int i = 0; i < na; i += nb){
+
+            int len = (na - i < nb) ? na - i : nb;
+
+            zpMulKaratsuba(a + i, len, b, nb, t);
+
+            for(int k = 0; k < len + nb - 1; k++) r[i + k] += t[k];
+        }
+
+        free(t);
+        return;
+    }
+
+    // Each level adds one bit to the half sums, far from overflowing a long long
+    // for int inputs below MUL_NTT_TERMS
+    int h = na / 2;
+    int ns = na - h;
+    long long *sa = (long long*)calloc(2 * ns, sizeof(long long));
+    __int128 *mid = (__int128*)malloc(2 * ns * sizeof(__int128));
+
+    if(sa == NULL || mid == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    long long *sb = sa + ns;
+
+    for(int i = 0; i < na - h; i++) sa[i] = a[h + i];
+    for(int i = 0; i < nb - h; i++) sb[i] = b[h + i];
+    for(int i = 0; i < h; i++) sa[i] += a[i];
+    for(int i = 0; i < h; i++) sb[i] += b[i];
+
+    zpMulKaratsuba(sa, ns, sb, ns, mid);
+
+    zpMulKaratsuba(a, h, b, h, t);
+
+    for(int k = 0; k < 2 * h - 1; k++){
+
+        mid[k] -= t[k];
+        r[k] += t[k];
+    }
+
+    zpMulKaratsuba(a + h, na - h, b + h, nb - h, t);
+
+    for(int k = 0; k < na + nb - 2 * h - 1; k++){
+
+        mid[k] -= t[k];
+        r[2 * h + k] += t[k];
+    }
+
+    for(int k = 0; k < 2 * ns - 1 && h + k < na + nb - 1; k++) r[h + k] += mid[k];
+
+    free(sa);
+    free(mid);
+    free(t);
+}
+
+//-----------------------------------------------------------------------------
+
+void nttTransform(const gfField* field, unsigned long long* a, int n, unsigned long long g, int inverse){
+
+    // a local copy of the field cannot alias a[], so its constants stay in registers
+    gfField local = *field;
+    const gfField *F = &local;
+    unsigned long long *w = (unsigned long long*)malloc((n / 2 + 1) * sizeof(unsigned long long));
+
+    if(w == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 1, j = 0; i < n; i++){
+
+        int bit = n >> 1;
+
+        for(; j & bit; bit >>= 1) j ^= bit;
+
+        j ^= bit;
+
+        if(i < j){
+
+            unsigned long long t = a[i];
+
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+
+    for(int len = 2; len <= n; len <<= 1){
+
+        unsigned long long root = gfPowMod(F, gfToMont(F, g), (F->p - 1) / len);
+
+        if(inverse) root = gfPowMod(F, root, len - 1);
+
+        w[0] = F->one;
+
+        for(int k = 1; k < len / 2; k++) w[k] = gfMulMod(F, w[k - 1], root);
+
+        for(int i = 0; i < n; i += len){
+
+            for(int k = 0; k < len / 2; k++){
+
+                unsigned long long u = a[i + k];
+                unsigned long long v = gfMulMod(F, a[i + k + len / 2], w[k]);
+
+                a[i + k] = gfAddMod(F, u, v);
+                a[i + k + len / 2] = gfSubMod(F, u, v);
+            }
+        }
+    }
+
+    if(inverse){
+
+        unsigned long long nInv = gfPowMod(F, gfToMont(F, n), F->p - 2);
+
+        for(int i = 0; i < n; i++) a[i] = gfMulMod(F, a[i], nInv);
+    }
+
+    free(w);
+}
+
+//-----------------------------------------------------------------------------
+
+void zpMulNtt(const long long* a, int da, const long long* b, int db, __int128* r){
+
+    const unsigned long long prime[2] = {NTT_PRIME_0, NTT_PRIME_1};
+    const unsigned long long root[2] = {NTT_ROOT_0, NTT_ROOT_1};
+    int square = (a == b && da == db);
+    int n = 1;
+
+    while(n < da + db + 1) n <<= 1;
+
+    unsigned long long *fa = (unsigned long long*)malloc(n * sizeof(unsigned long long));
+    unsigned long long *fb = (unsigned long long*)malloc(n * sizeof(unsigned long long));
+    unsigned long long *res = (unsigned long long*)malloc((da + db + 1) * sizeof(unsigned long long));
+
+    if(fa == NULL || fb == NULL || res == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int t = 0; t < 2; t++){
+
+        gfField F = gfInit(prime[t]);
+
+        for(int i = 0; i < n; i++){
+
+            long long x = (i <= da) ? a[i] % (long long)prime[t] : 0;
+            long long y = (i <= db) ? b[i] % (long long)prime[t] : 0;
+
+            fa[i] = gfToMont(&F, (unsigned long long)((x < 0) ? x + (long long)prime[t] : x));
+            fb[i] = gfToMont(&F, (unsigned long long)((y < 0) ? y + (long long)prime[t] : y));
+        }
+
+        nttTransform(&F, fa, n, root[t], 0);
+
+        if(!square) nttTransform(&F, fb, n, root[t], 0);
+
+        for(int i = 0; i < n; i++) fa[i] = gfMulMod(&F, fa[i], square ? fa[i] : fb[i]);
+
+        nttTransform(&F, fa, n, root[t], 1);
+
+        // Garner with balanced digits lands in (-p0 p1 / 2, p0 p1 / 2)
+        if(t == 0){
+
+            for(int i = 0; i <= da + db; i++) res[i] = gfFromMont(&F, fa[i]);
+        }
+        else{
+
+            unsigned long long inv = powMod(NTT_PRIME_0 % NTT_PRIME_1, NTT_PRIME_1 - 2, NTT_PRIME_1);
+
+            for(int i = 0; i <= da + db; i++){
+
+                long long v0 = (res[i] > NTT_PRIME_0 / 2) ? (long long)(res[i] - NTT_PRIME_0) : (long long)res[i];
+                __int128 d = ((__int128)gfFromMont(&F, fa[i]) - v0) % (__int128)NTT_PRIME_1;
+                unsigned long long v1 = mulMod((unsigned long long)((d < 0) ? d + NTT_PRIME_1 : d), inv, NTT_PRIME_1);
+                long long s1 = (v1 > NTT_PRIME_1 / 2) ? (long long)(v1 - NTT_PRIME_1) : (long long)v1;
+
+                r[i] = v0 + (__int128)s1 * NTT_PRIME_0;
+            }
+        }
+    }
+
+    free(fa);
+    free(fb);
+    free(res);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigPolyMul(const bigInt* a, int da, const bigInt* b, int db, bigInt* r){
+
+    bigInt *part = (bigInt*)malloc(2 * (da + db + 2) * sizeof(bigInt));
+    bigInt *prod = (bigInt*)malloc((da + db + 1) * sizeof(bigInt));
+
+    if(part == NULL || prod == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // Kronecker substitution needs non-negative digits: a b is expanded from
+    // the positive and negative parts of each operand, which share limbs with a, b
+    bigInt *aPart = part, *bPart = part + 2 * (da + 1);
+
+    for(int i = 0; i <= da; i++){
+
+        aPart[i] = aPart[da + 1 + i] = a[i];
+
+        if(a[i].sign < 0) aPart[i].size = 0;
+        else aPart[da + 1 + i].size = 0;
+    }
+
+    for(int i = 0; i <= db; i++){
+
+        bPart[i] = bPart[db + 1 + i] = b[i];
+
+        if(b[i].sign < 0) bPart[i].size = 0;
+        else bPart[db + 1 + i].size = 0;
+    }
+
+    for(int k = 0; k <= da + db; k++){
+
+        bigInit(&r[k], 0);
+        bigInit(&prod[k], 0);
+    }
+
+    for(int s = 0; s < 2; s++){
+
+        for(int t = 0; t < 2; t++){
+
+            bigPolyMulNonNeg(aPart + s * (da + 1), da, bPart + t * (db + 1), db, prod);
+
+            for(int k = 0; k <= da + db; k++){
+
+                if(s != t) prod[k].sign = -prod[k].sign;
+
+                bigAdd(&r[k], &prod[k]);
+            }
+        }
+    }
+
+    for(int k = 0; k <= da + db; k++) bigFree(&prod[k]);
+
+    free(part);
+    free(prod);
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pMul(polynomial a, polynomial b){
+
+    if(a.numTerms == 0 || b.numTerms == 0) return pCreate(0);
+
+    polynomial fa = pDense(a), fb = pDense(b);
+    int da = fa.numTerms - 1, db = fb.numTerms - 1;
+    int big = 0;
+    polynomial result = pCreate(da + db + 1);
+
+    for(int i = 0; i <= da; i++) big |= (fa.terms[i].big != NULL);
+    for(int i = 0; i <= db; i++) big |= (fb.terms[i].big != NULL);
+
+    if(big){
+
+        bigInt *ca = (bigInt*)malloc((da + db + 2) * sizeof(bigInt));
+        bigInt *cr = (bigInt*)malloc((da + db + 1) * sizeof(bigInt));
+
+        if(ca == NULL || cr == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        bigInt *cb = ca + da + 1;
+
+        for(int i = 0; i <= da; i++) termToBig(fa.terms[da - i], &ca[i]);
+        for(int i = 0; i <= db; i++) termToBig(fb.terms[db - i], &cb[i]);
+
+        bigPolyMul(ca, da, cb, db, cr);
+
+        for(int k = 0; k <= da + db; k++) result.terms[da + db - k] = termFromBig(&cr[k], k);
+
+        for(int i = 0; i < da + db + 2; i++) bigFree(&ca[i]);
+
+        free(ca);
+        free(cr);
+    }
+    else{
+
+        long long *ca = (long long*)malloc((da + db + 2) * sizeof(long long));
+        __int128 *cr = (__int128*)malloc((da + db + 1) * sizeof(__int128));
+
+        if(ca == NULL || cr == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        // squaring is detected so that zpMulNtt() transforms the operand once
+        long long *cb = (a.terms == b.terms && a.numTerms == b.numTerms) ? ca : ca + da + 1;
+        int shorter = (da < db) ? da + 1 : db + 1;
+
+        for(int i = 0; i <= da; i++) ca[i] = fa.terms[da - i].coefficient;
+        for(int i = 0; i <= db; i++) cb[i] = fb.terms[db - i].coefficient;
+
+        if(shorter < MUL_NTT_TERMS) zpMulKaratsuba(ca, da + 1, cb, db + 1, cr);
+        else zpMulNtt(ca, da, cb, db, cr);
+
+        for(int k = 0; k <= da + db; k++) result.terms[da + db - k] = termFromInt128(cr[k], k);
+
+        free(ca);
+        free(cr);
+    }
+
+    termsFree(fa.terms, fa.numTerms);
+    termsFree(fb.terms, fb.numTerms);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pPow(polynomial p, int e){
+
+    if(e < 0 || p.numTerms == 0) return pCreate(0);
+
+    polynomial result = pCreate(1);
+    polynomial base = pDense(p);
+
+    result.terms[0] = setTerms(1, 0);
+
+    while(e > 0){
+
+        if(e & 1){
+
+            polynomial t = pMul(result, base);
+
+            termsFree(result.terms, result.numTerms);
+            result = t;
+        }
+
+        e >>= 1;
+
+        if(e > 0){
+
+            polynomial t = pMul(base, base);
+
+            termsFree(base.terms, base.numTerms);
+            base = t;
+        }
+    }
+
+    termsFree(base.terms, base.numTerms);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigAddProduct(bigInt* r, const bigInt* a, const bigInt* b){
+
+    if(a->sign == 0 || b->sign == 0) return;
+
+    if(b->size == 1 && b->limb[0] <= LLONG_MAX){
+
+        bigAddMul(r, a, b->sign * (long long)b->limb[0]);
+        return;
+    }
+
+    if(a->size == 1 && a->limb[0] <= LLONG_MAX){
+
+        bigAddMul(r, b, a->sign * (long long)a->limb[0]);
+        return;
+    }
+
+    bigInt t;
+
+    bigInit(&t, 0);
+    bigReserve(&t, a->size + b->size);
+    limbMul(a->limb, a->size, b->limb, b->size, t.limb);
+
+    t.size = a->size + b->size;
+
+    while(t.size > 0 && t.limb[t.size - 1] == 0) t.size--;
+
+    t.sign = a->sign * b->sign;
+
+    bigAdd(r, &t);
+    bigFree(&t);
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpTermDesc(const void* a, const void* b){
+
+    int x = ((const term*)a)->exponent;
+    int y = ((const term*)b)->exponent;
+
+    return (x < y) - (x > y);
+}
+
+//-----------------------------------------------------------------------------
+
+term* sparseTerms(polynomial p, int* count){
+
+    term *t = (term*)malloc((p.numTerms + 1) * sizeof(term));
+
+    if(t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i < p.numTerms; i++) t[i] = p.terms[i];
+
+    qsort(t, p.numTerms, sizeof(term), cmpTermDesc);
+
+    // repeated exponents are summed into fresh terms, so t never shares p's heap coefficients
+    *count = 0;
+
+    for(int i = 0; i < p.numTerms; i++){
+
+        term sum = setTerms(0, t[i].exponent);
+
+        termAdd(&sum, t[i]);
+
+        while(i + 1 < p.numTerms && t[i + 1].exponent == sum.exponent) termAdd(&sum, t[++i]);
+
+        if(sum.coefficient != 0) t[(*count)++] = sum;
+    }
+
+    return t;
+}
+
+//-----------------------------------------------------------------------------
+
+void sparseHeapPush(sparseHeap* h, unsigned long long key, int row){
+
+    int pos = h->size;
+
+    // an equal key where the new entry would stop takes it into its chain
+    while(pos > 0 && h->key[(pos - 1) / 2] < key) pos = (pos - 1) / 2;
+
+    if(pos > 0 && h->key[(pos - 1) / 2] == key){
+
+        h->next[row] = h->head[(pos - 1) / 2];
+        h->head[(pos - 1) / 2] = row;
+        return;
+    }
+
+    for(int q = h->size; q > pos; q = (q - 1) / 2){
+
+        h->key[q] = h->key[(q - 1) / 2];
+        h->head[q] = h->head[(q - 1) / 2];
+    }
+
+    h->key[pos] = key;
+    h->head[pos] = row;
+    h->next[row] = -1;
+    h->size++;
+}
+
+//-----------------------------------------------------------------------------
+
+int sparseHeapPop(sparseHeap* h){
+
+    int chain = h->head[0];
+    unsigned long long key = h->key[--h->size];
+    int last = h->head[h->size];
+    int pos = 0;
+
+    while(2 * pos + 1 < h->size){
+
+        int child = 2 * pos + 1;
+
+        if(child + 1 < h->size && h->key[child + 1] > h->key[child]) child++;
+
+        if(h->key[child] <= key) break;
+
+        h->key[pos] = h->key[child];
+        h->head[pos] = h->head[child];
+        pos = child;
+    }
+
+    h->key[pos] = key;
+    h->head[pos] = last;
+
+    return chain;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial pMulSparse(polynomial a, polynomial b){
+
+    int na = 0, nb = 0;
+    term *fa = sparseTerms(a, &na);
+    term *fb = sparseTerms(b, &nb);
+
+    if(na > nb){
+
+        term *t = fa;
+        int nt = na;
+
+        fa = fb;
+        na = nb;
+        fb = t;
+        nb = nt;
+    }
+
+    long long top = (na > 0 && nb > 0) ? (long long)fa[0].exponent + fb[0].exponent : -1;
+
+    if(top < 0 || top > INT_MAX || (long long)na * nb >= SPARSE_MUL_DENSITY * (top + 1)){
+
+        polynomial result = (top >= 0 && top <= INT_MAX) ? pMul(a, b) : pCreate(0);
+
+        termsFree(fa, na);
+        termsFree(fb, nb);
+        removeZeros(&result);
+
+        return result;
+    }
+
+    int big = 0;
+
+    for(int i = 0; i < na; i++) big |= (fa[i].big != NULL);
+    for(int j = 0; j < nb; j++) big |= (fb[j].big != NULL);
+
+    sparseHeap h;
+    int *col = (int*)malloc(na * sizeof(int));
+    int *rows = (int*)malloc(na * sizeof(int));
+    bigInt *ca = big ? (bigInt*)malloc((na + nb) * sizeof(bigInt)) : NULL;
+    int count = 0, cap = 16;
+    polynomial result;
+
+    h.key = (unsigned long long*)malloc(na * sizeof(unsigned long long));
+    h.head = (int*)malloc(na * sizeof(int));
+    h.next = (int*)malloc(na * sizeof(int));
+    h.size = 0;
+    result.terms = (term*)malloc(cap * sizeof(term));
+
+    if(col == NULL || rows == NULL || (big && ca == NULL) || h.key == NULL || h.head == NULL || h.next == NULL || result.terms == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInt *cb = big ? ca + na : NULL;
+
+    if(big){
+
+        for(int i = 0; i < na; i++) termToBig(fa[i], &ca[i]);
+        for(int j = 0; j < nb; j++) termToBig(fb[j], &cb[j]);
+    }
+
+    // a single exponent needs no packing: the 64-bit key is the exponent sum.
+    // Row i enters the heap at (i, 0) once (i - 1, 0) leaves it, so the heap
+    // never holds more than na entries
+    col[0] = 0;
+    sparseHeapPush(&h, (unsigned long long)top, 0);
+
+    while(h.size > 0){
+
+        unsigned long long key = h.key[0];
+        int numRows = 0;
+        __int128 acc = 0;
+        bigInt accBig;
+
+        if(big) bigInit(&accBig, 0);
+
+        while(h.size > 0 && h.key[0] == key){
+
+            for(int i = sparseHeapPop(&h); i >= 0; i = h.next[i]){
+
+                if(big) bigAddProduct(&accBig, &ca[i], &cb[col[i]]);
+                else acc += (__int128)fa[i].coefficient * fb[col[i]].coefficient;
+
+                rows[numRows++] = i;
+            }
+        }
+
+        for(int k = 0; k < numRows; k++){
+
+            int i = rows[k];
+
+            if(col[i] == 0 && i + 1 < na){
+
+                col[i + 1] = 0;
+                sparseHeapPush(&h, (unsigned long long)fa[i + 1].exponent + fb[0].exponent, i + 1);
+            }
+
+            if(++col[i] < nb) sparseHeapPush(&h, (unsigned long long)fa[i].exponent + fb[col[i]].exponent, i);
+        }
+
+        if(big ? accBig.sign == 0 : acc == 0){
+
+            if(big) bigFree(&accBig);
+
+            continue;
+        }
+
+        if(count == cap){
+
+            term *grown = (term*)realloc(result.terms, 2 * cap * sizeof(term));
+
+            if(grown == NULL){
+
+                printf("\nError allocating memory.");
+                exit(1);
+            }
+
+            result.terms = grown;
+            cap *= 2;
+        }
+
+        result.terms[count++] = big ? termFromBig(&accBig, (int)key) : termFromInt128(acc, (int)key);
+    }
+
+    result.numTerms = count;
+
+    if(big){
+
+        for(int i = 0; i < na + nb; i++) bigFree(&ca[i]);
+    }
+
+    termsFree(fa, na);
+    termsFree(fb, nb);
+    free(ca);
+    free(col);
+    free(rows);
+    free(h.key);
+    free(h.head);
+    free(h.next);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+bigInt* bigsCreate(int n){
+
+    bigInt *x = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+    if(x == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i < n; i++) bigInit(&x[i], 0);
+
+    return x;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigsFree(bigInt* x, int n){
+
+    for(int i = 0; i < n; i++) bigFree(&x[i]);
+
+    free(x);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigMul(bigInt* x, const bigInt* m){
+
+    bigInt t;
+
+    bigInit(&t, 0);
+    bigAddProduct(&t, x, m);
+    bigFree(x);
+
+    *x = t;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigPolyDivClassical(bigInt* R, int m, const bigInt* B, int n, bigInt* Q, bigInt* D){
+
+    int k = m - n + 1;
+    int unit = (B[n].size == 1 && B[n].limb[0] == 1);
+
+    bigInit(D, 1);
+
+    // pseudo-division: unless the leading coefficient c is a unit, every step
+    // scales the partial remainder and quotient by c, so c^k A = B Q + R exactly
+    for(int j = k - 1; j >= 0; j--){
+
+        Q[j] = R[n + j];
+        bigInit(&R[n + j], 0);
+
+        if(unit) Q[j].sign *= B[n].sign;
+        else{
+
+            for(int i = 0; i < n + j; i++) bigMul(&R[i], &B[n]);
+            for(int i = j + 1; i < k; i++) bigMul(&Q[i], &B[n]);
+
+            bigMul(D, &B[n]);
+        }
+
+        bigInt t = Q[j];
+
+        t.sign = -t.sign;
+
+        for(int i = 0; i < n; i++) bigAddProduct(&R[i + j], &t, &B[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long nttPrimeBelow(unsigned long long* h, unsigned long long* g){
+
+    // primes h 2^32 + 1 below 2^62 take transforms of any int length, and a
+    // quadratic non-residue g has the full power of two in its order
+    for(;;){
+
+        unsigned long long p = (--(*h) << 32) + 1;
+
+        if(!isPrime(p)) continue;
+
+        gfField F = gfInit(p);
+
+        for(*g = 3; gfPowMod(&F, gfToMont(&F, *g), (p - 1) / 2) == F.one; (*g)++);
+
+        return p;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void gfPolyMulNtt(const gfField* F, unsigned long long g, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long* r){
+
+    if(da < MUL_KARATSUBA_TERMS || db < MUL_KARATSUBA_TERMS){
+
+        for(int i = 0; i <= da + db; i++) r[i] = 0;
+
+        for(int i = 0; i <= da; i++){
+
+            for(int j = 0; j <= db; j++) r[i + j] = gfAddMod(F, r[i + j], gfMulMod(F, a[i], b[j]));
+        }
+
+        return;
+    }
+
+    int n = 1;
+
+    while(n < da + db + 1) n <<= 1;
+
+    unsigned long long *fa = (unsigned long long*)calloc(n, sizeof(unsigned long long));
+    unsigned long long *fb = (unsigned long long*)calloc(n, sizeof(unsigned long long));
+
+    if(fa == NULL || fb == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= da; i++) fa[i] = a[i];
+    for(int i = 0; i <= db; i++) fb[i] = b[i];
+
+    nttTransform(F, fa, n, g, 0);
+    nttTransform(F, fb, n, g, 0);
+
+    for(int i = 0; i < n; i++) fa[i] = gfMulMod(F, fa[i], fb[i]);
+
+    nttTransform(F, fa, n, g, 1);
+
+    for(int i = 0; i <= da + db; i++) r[i] = fa[i];
+
+    free(fa);
+    free(fb);
+}
+
+//-----------------------------------------------------------------------------
+
+void gfPolyRecip(const gfField* F, unsigned long long g, const unsigned long long* b, int n, int k, unsigned long long* inv){
+
+    int steps[32], numSteps = 0;
+    int s = 1;
+    unsigned long long *e = (unsigned long long*)malloc((n + k + 1) * sizeof(unsigned long long));
+    unsigned long long *t = (unsigned long long*)malloc((k + 1) * sizeof(unsigned long long));
+
+    if(e == NULL || t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int len = k; len > 1; len = (len + 1) / 2) steps[numSteps++] = len;
+
+    inv[0] = gfPowMod(F, b[0], F->p - 2);
+
+    // inv_len = inv_s - inv_s (b inv_s - 1) mod x^len, and b inv_s - 1 starts at x^s
+    while(numSteps > 0){
+
+        int len = steps[--numSteps];
+        int db = (n < len - 1) ? n : len - 1;
+
+        gfPolyMulNtt(F, g, b, db, inv, s - 1, e);
+
+        for(int i = 0; i < len - s; i++) t[i] = (s + i <= db + s - 1) ? e[s + i] : 0;
+
+        gfPolyMulNtt(F, g, inv, s - 1, t, len - s - 1, e);
+
+        for(int i = 0; i < len - s; i++) inv[s + i] = gfSubMod(F, 0, e[i]);
+
+        s = len;
+    }
+
+    free(e);
+    free(t);
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfFromLong(const gfField* F, long long x){
+
+    return gfToMont(F, (x < 0) ? F->p - (unsigned long long)(-x) : (unsigned long long)x);
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfFromBig(const gfField* F, const bigInt* x){
+
+    unsigned long long u = bigModSmall(x, F->p);
+
+    return gfToMont(F, (x->sign < 0 && u != 0) ? F->p - u : u);
+}
+
+//-----------------------------------------------------------------------------
+
+int crtStep(bigInt* x, int count, const bigInt* M, const unsigned long long* r, unsigned long long p){
+
+    unsigned long long mInv = powMod(bigModSmall(M, p), p - 2, p);
+    int stable = 1;
+
+    // x = r mod p with a balanced digit, so x stays within (-M p / 2, M p / 2]
+    for(int i = 0; i < count; i++){
+
+        unsigned long long y = bigModSmall(&x[i], p);
+
+        if(x[i].sign < 0 && y != 0) y = p - y;
+
+        if(y == r[i]) continue;
+
+        unsigned long long t = mulMod((r[i] >= y) ? r[i] - y : r[i] + p - y, mInv, p);
+
+        bigAddMul(&x[i], M, (t > p / 2) ? (long long)t - (long long)p : (long long)t);
+        stable = 0;
+    }
+
+    return stable;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigPolyDivModular(const bigInt* A, int m, const bigInt* B, int n, bigInt* Q, bigInt* R){
+
+    int k = m - n + 1;
+    unsigned long long h = 1ULL << 30, g;
+    unsigned long long *rb = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    unsigned long long *ra = (unsigned long long*)malloc(k * sizeof(unsigned long long));
+    unsigned long long *inv = (unsigned long long*)malloc(k * sizeof(unsigned long long));
+    unsigned long long *qr = (unsigned long long*)malloc(2 * k * sizeof(unsigned long long));
+    bigInt *P = (bigInt*)malloc((m + 1) * sizeof(bigInt));
+    bigInt M;
+
+    if(rb == NULL || ra == NULL || inv == NULL || qr == NULL || P == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&M, 1);
+
+    for(int j = 0; j < k; j++) bigInit(&Q[j], 0);
+
+    // B has leading coefficient 1 or -1, so Q is integral: its residues under
+    // word primes are joined by CRT until a new prime changes nothing, and the
+    // candidate is then checked with one exact product
+    for(;;){
+
+        unsigned long long p = nttPrimeBelow(&h, &g);
+        gfField F = gfInit(p);
+
+        for(int i = 0; i <= n; i++) rb[i] = gfFromBig(&F, &B[n - i]);
+        for(int i = 0; i < k; i++) ra[i] = gfFromBig(&F, &A[m - i]);
+
+        gfPolyRecip(&F, g, rb, n, k, inv);
+        gfPolyMulNtt(&F, g, ra, k - 1, inv, k - 1, qr);
+
+        for(int j = 0; j < k; j++) ra[j] = gfFromMont(&F, qr[k - 1 - j]);
+
+        int stable = crtStep(Q, k, &M, ra, p);
+
+        bigScale(&M, (long long)p);
+
+        if(!stable) continue;
+
+        bigPolyMul(B, n, Q, k - 1, P);
+
+        int exact = 1;
+
+        for(int i = 0; i <= m; i++){
+
+            P[i].sign = -P[i].sign;
+            bigAdd(&P[i], &A[i]);
+
+            if(i >= n && P[i].sign != 0) exact = 0;
+        }
+
+        if(exact){
+
+            for(int i = 0; i < n; i++) R[i] = P[i];
+            for(int i = n; i <= m; i++) bigFree(&P[i]);
+
+            break;
+        }
+
+        for(int i = 0; i <= m; i++) bigFree(&P[i]);
+    }
+
+    bigFree(&M);
+    free(rb);
+    free(ra);
+    free(inv);
+    free(qr);
+    free(P);
+}
+
+//-----------------------------------------------------------------------------
+
+term pDivRem(polynomial a, polynomial b, polynomial* q, polynomial* r){
+
+    int m, n;
+    bigInt *A = bigsFromPoly(a, &m), *B = bigsFromPoly(b, &n);
+
+    if(n < 0){
+
+        bigsFree(A, m + 1);
+        bigsFree(B, n + 1);
+
+        *q = pCreate(0);
+        *r = pCreate(0);
+
+        return setTerms(0, 0);
+    }
+
+    int k = (m >= n) ? m - n + 1 : 0;
+    int rn = (m >= n) ? n : m + 1, rAlloc = m + 1;
+    bigInt *Q = (bigInt*)malloc((k + 1) * sizeof(bigInt));
+    bigInt *R = A;
+    bigInt D;
+
+    if(Q == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&D, 1);
+
+    int small = (B[n].size == 1 && B[n].limb[0] <= LLONG_MAX);
+
+    if(k >= DIVREM_NEWTON_TERMS && n >= DIVREM_NEWTON_TERMS && B[n].size == 1 && B[n].limb[0] == 1){
+
+        R = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+        if(R == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        bigPolyDivModular(A, m, B, n, Q, R);
+        bigsFree(A, m + 1);
+
+        rAlloc = n;
+    }
+    else if(k > 0){
+
+        bigFree(&D);
+        bigPolyDivClassical(R, m, B, n, Q, &D);
+    }
+
+    // D is a power of c, so a prime shared by D, Q and R divides c: removing
+    // gcd(c, D, Q, R) until it is 1 leaves the least common denominator
+    while(small && D.size > 0){
+
+        unsigned long long g = B[n].limb[0];
+
+        g = ullGcd(g, bigModSmall(&D, g));
+
+        for(int i = 0; i < k && g > 1; i++) g = ullGcd(g, bigModSmall(&Q[i], g));
+        for(int i = 0; i < rn && g > 1; i++) g = ullGcd(g, bigModSmall(&R[i], g));
+
+        if(g <= 1) break;
+
+        bigDivSmall(&D, (long long)g);
+
+        for(int i = 0; i < k; i++) bigDivSmall(&Q[i], (long long)g);
+        for(int i = 0; i < rn; i++) bigDivSmall(&R[i], (long long)g);
+    }
+
+    if(D.sign < 0){
+
+        D.sign = 1;
+
+        for(int i = 0; i < k; i++) Q[i].sign = -Q[i].sign;
+        for(int i = 0; i < rn; i++) R[i].sign = -R[i].sign;
+    }
+
+    while(rn > 0 && R[rn - 1].sign == 0) rn--;
+
+    *q = pCreate(k);
+    *r = pCreate(rn);
+
+    for(int i = 0; i < k; i++) q->terms[i] = termFromBig(&Q[k - 1 - i], k - 1 - i);
+    for(int i = 0; i < rn; i++) r->terms[i] = termFromBig(&R[rn - 1 - i], rn - 1 - i);
+
+    for(int i = rn; i < rAlloc; i++) bigFree(&R[i]);
+
+    free(R);
+    free(Q);
+    bigsFree(B, n + 1);
+
+    return termFromBig(&D, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+bigInt* bigsFromPoly(polynomial p, int* deg){
+
+    polynomial dense = pDense(p);
+    int top = 0;
+
+    while(top < dense.numTerms && dense.terms[top].coefficient == 0) top++;
+
+    *deg = dense.numTerms - 1 - top;
+
+    bigInt *c = (bigInt*)malloc((*deg + 2) * sizeof(bigInt));
+
+    if(c == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= *deg; i++) termToBig(dense.terms[dense.numTerms - 1 - i], &c[i]);
+
+    termsFree(dense.terms, dense.numTerms);
+
+    return c;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigDivMod(const bigInt* a, const bigInt* b, bigInt* q, bigInt* r){
+
+    int n = b->size, m = a->size - b->size;
+    int sa = a->sign, sb = b->sign;
+
+    // q or r may alias a or b, so the signs are read before either is written
+    if(m < 0){
+
+        if(r != a){
+
+            bigReserve(r, a->size);
+
+            for(int i = 0; i < a->size; i++) r->limb[i] = a->limb[i];
+
+            r->size = a->size;
+            r->sign = sa;
+        }
+
+        if(q != NULL) q->size = q->sign = 0;
+
+        return;
+    }
+
+    int s = __builtin_clzll(b->limb[n - 1]);
+    unsigned long long *un = (unsigned long long*)malloc((a->size + 1) * sizeof(unsigned long long));
+    unsigned long long *vn = (unsigned long long*)malloc(n * sizeof(unsigned long long));
+    unsigned long long *qn = (unsigned long long*)malloc((m + 1) * sizeof(unsigned long long));
+
+    if(un == NULL || vn == NULL || qn == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // Knuth's algorithm D: with the divisor normalized so its top bit is set,
+    // the quotient digit guessed from the leading limbs is at most two too large
+    for(int i = n - 1; i > 0; i--) vn[i] = (b->limb[i] << s) | (s ? b->limb[i - 1] >> (64 - s) : 0);
+
+    vn[0] = b->limb[0] << s;
+    un[a->size] = s ? a->limb[a->size - 1] >> (64 - s) : 0;
+
+    for(int i = a->size - 1; i > 0; i--) un[i] = (a->limb[i] << s) | (s ? a->limb[i - 1] >> (64 - s) : 0);
+
+    un[0] = a->limb[0] << s;
+
+    for(int j = m; j >= 0; j--){
+
+        unsigned __int128 num = ((unsigned __int128)un[j + n] << 64) | un[j + n - 1];
+        unsigned __int128 qhat = num / vn[n - 1], rhat = num % vn[n - 1];
+
+        while(n > 1 && ((qhat >> 64) || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2]))){
+
+            qhat--;
+            rhat += vn[n - 1];
+
+            if(rhat >> 64) break;
+        }
+
+        unsigned long long borrow = 0, carry = 0;
+
+        for(int i = 0; i < n; i++){
+
+            unsigned __int128 p = qhat * vn[i] + carry;
+            unsigned long long lo = (unsigned long long)p;
+            unsigned long long t = un[i + j] - lo;
+            unsigned long long b1 = (un[i + j] < lo);
+
+            carry = (unsigned long long)(p >> 64);
+            un[i + j] = t - borrow;
+            borrow = b1 + (t < borrow);
+        }
+
+        int negative = ((unsigned __int128)un[j + n] < (unsigned __int128)carry + borrow);
+
+        un[j + n] = un[j + n] - carry - borrow;
+
+        if(negative){
+
+            unsigned long long c = 0;
+
+            qhat--;
+
+            for(int i = 0; i < n; i++){
+
+                unsigned __int128 t = (unsigned __int128)un[i + j] + vn[i] + c;
+
+                un[i + j] = (unsigned long long)t;
+                c = (unsigned long long)(t >> 64);
+            }
+
+            un[j + n] += c;
+        }
+
+        qn[j] = (unsigned long long)qhat;
+    }
+
+    if(q != NULL){
+
+        bigReserve(q, m + 1);
+
+        for(int i = 0; i <= m; i++) q->limb[i] = qn[i];
+
+        q->size = m + 1;
+
+        while(q->size > 0 && q->limb[q->size - 1] == 0) q->size--;
+
+        q->sign = (q->size > 0) ? sa * sb : 0;
+    }
+
+    bigReserve(r, n);
+
+    for(int i = 0; i < n; i++) r->limb[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+
+    r->size = n;
+
+    while(r->size > 0 && r->limb[r->size - 1] == 0) r->size--;
+
+    r->sign = (r->size > 0) ? sa : 0;
+
+    free(un);
+    free(vn);
+    free(qn);
+}
+
+//-----------------------------------------------------------------------------
+
+void bigGcd(const bigInt* a, const bigInt* b, bigInt* g){
+
+    bigInt x, y;
+
+    bigInit(&x, 0);
+    bigInit(&y, 0);
+    bigAdd(&x, a);
+    bigAdd(&y, b);
+
+    x.sign = (x.size > 0);
+    y.sign = (y.size > 0);
+
+    while(y.sign != 0){
+
+        bigInt r;
+
+        bigInit(&r, 0);
+        bigDivMod(&x, &y, NULL, &r);
+        bigFree(&x);
+
+        x = y;
+        y = r;
+        x.sign = (x.size > 0);
+    }
+
+    bigFree(&y);
+    bigFree(g);
+
+    *g = x;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigLcmRange(const bigInt* w, int lo, int hi, bigInt* out){
+
+    bigFree(out);
+    bigInit(out, 0);
+
+    if(hi - lo == 1){
+
+        bigAdd(out, &w[lo]);
+        out->sign = (out->size > 0);
+        return;
+    }
+
+    // halves keep the gcds balanced instead of growing one operand
+    bigInt left, right, g;
+
+    bigInit(&left, 0);
+    bigInit(&right, 0);
+    bigInit(&g, 0);
+    bigLcmRange(w, lo, (lo + hi) / 2, &left);
+    bigLcmRange(w, (lo + hi) / 2, hi, &right);
+    bigGcd(&left, &right, &g);
+    bigDivMod(&left, &g, out, &g);
+    bigMul(out, &right);
+
+    bigFree(&left);
+    bigFree(&right);
+    bigFree(&g);
+}
+
+//-----------------------------------------------------------------------------
+
+long long gfTreeBuild(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, int index, int lo, int hi){
+
+    unsigned long long *P = (unsigned long long*)calloc(hi - lo + 1, sizeof(unsigned long long));
+
+    if(P == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    node[index] = P;
+
+    if(hi - lo <= TREE_LEAF_POINTS){
+
+        // a leaf is expanded one linear factor at a time
+        P[0] = F->one;
+
+        for(int j = lo; j < hi; j++){
+
+            unsigned long long x = gfFromLong(F, points[j]);
+            int s = j - lo;
+
+            P[s + 1] = P[s];
+
+            for(int i = s; i > 0; i--) P[i] = gfSubMod(F, P[i - 1], gfMulMod(F, P[i], x));
+
+            P[0] = gfSubMod(F, 0, gfMulMod(F, P[0], x));
+        }
+
+        return hi - lo + 1;
+    }
+
+    int mid = (lo + hi) / 2;
+    long long words = hi - lo + 1;
+
+    words += gfTreeBuild(F, g, points, node, 2 * index, lo, mid);
+    words += gfTreeBuild(F, g, points, node, 2 * index + 1, mid, hi);
+
+    gfPolyMulNtt(F, g, node[2 * index], mid - lo, node[2 * index + 1], hi - mid, P);
+
+    return words;
+}
+
+//-----------------------------------------------------------------------------
+
+void gfPolyRemMonic(const gfField* F, unsigned long long g, const unsigned long long* a, int da, const unsigned long long* b, int db, unsigned long long** recip, unsigned long long* r){
+
+    int k = da - db + 1;
+
+    if(k < TREE_NEWTON_TERMS || db < TREE_NEWTON_TERMS){
+
+        int len = (da + 1 > db) ? da + 1 : db;
+        unsigned long long *t = (unsigned long long*)calloc(len + 1, sizeof(unsigned long long));
+
+        if(t == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for(int i = 0; i <= da; i++) t[i] = a[i];
+
+        if(k > 0) gfPolyDivRem(F, t, da, b, db, NULL);
+
+        for(int i = 0; i < db; i++) r[i] = t[i];
+
+        free(t);
+
+        return;
+    }
+
+    int low = (k < db) ? k : db;
+    unsigned long long *inv = (recip != NULL) ? *recip : NULL;
+    unsigned long long *ra = (unsigned long long*)malloc(k * sizeof(unsigned long long));
+    unsigned long long *e = (unsigned long long*)malloc((2 * k + db) * sizeof(unsigned long long));
+
+    if(ra == NULL || e == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // the reversed quotient is rev(a) / rev(b) mod x^k, and only its low
+    // db coefficients reach the remainder a - b q below x^db
+    if(inv == NULL){
+
+        unsigned long long *rb = (unsigned long long*)malloc((db + 1) * sizeof(unsigned long long));
+
+        inv = (unsigned long long*)malloc(k * sizeof(unsigned long long));
+
+        if(rb == NULL || inv == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for(int i = 0; i <= db; i++) rb[i] = b[db - i];
+
+        gfPolyRecip(F, g, rb, db, k, inv);
+        free(rb);
+
+        if(recip != NULL) *recip = inv;
+    }
+
+    for(int i = 0; i < k; i++) ra[i] = a[da - i];
+
+    gfPolyMulNtt(F, g, ra, k - 1, inv, k - 1, e);
+
+    for(int i = 0; i < low; i++) ra[i] = e[k - 1 - i];
+
+    gfPolyMulNtt(F, g, b, db - 1, ra, low - 1, e);
+
+    for(int i = 0; i < db; i++) r[i] = gfSubMod(F, a[i], e[i]);
+
+    if(recip == NULL) free(inv);
+
+    free(ra);
+    free(e);
+}
+
+//-----------------------------------------------------------------------------
+
+void gfTreeEval(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, unsigned long long** recip, int index, int lo, int hi, const unsigned long long* r, unsigned long long* out){
+
+    if(hi - lo <= TREE_LEAF_POINTS){
+
+        for(int j = lo; j < hi; j++){
+
+            unsigned long long x = gfFromLong(F, points[j]), v = 0;
+
+            for(int i = hi - lo - 1; i >= 0; i--) v = gfAddMod(F, gfMulMod(F, v, x), r[i]);
+
+            out[j] = v;
+        }
+
+        return;
+    }
+
+    int mid = (lo + hi) / 2;
+    unsigned long long *rl = (unsigned long long*)malloc((hi - lo) * sizeof(unsigned long long));
+
+    if(rl == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    unsigned long long *rr = rl + (mid - lo);
+
+    // the remainder modulo a node is reduced once for each child, and the
+    // reciprocals used for that depend only on the children
+    gfPolyRemMonic(F, g, r, hi - lo - 1, node[2 * index], mid - lo, &recip[2 * index], rl);
+    gfPolyRemMonic(F, g, r, hi - lo - 1, node[2 * index + 1], hi - mid, &recip[2 * index + 1], rr);
+
+    gfTreeEval(F, g, points, node, recip, 2 * index, lo, mid, rl, out);
+    gfTreeEval(F, g, points, node, recip, 2 * index + 1, mid, hi, rr, out);
+
+    free(rl);
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long* gfTreeCombine(const gfField* F, unsigned long long g, const int* points, unsigned long long** node, int index, int lo, int hi, const unsigned long long* c){
+
+    int s = hi - lo;
+    unsigned long long *out = (unsigned long long*)calloc(s, sizeof(unsigned long long));
+
+    if(out == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    if(s <= TREE_LEAF_POINTS){
+
+        const unsigned long long *P = node[index];
+
+        // P / (x - x_j) by synthetic division, weighted by c_j
+        for(int j = lo; j < hi; j++){
+
+            unsigned long long x = gfFromLong(F, points[j]), q = P[s];
+
+            for(int i = s - 1; i >= 0; i--){
+
+                out[i] = gfAddMod(F, out[i], gfMulMod(F, c[j], q));
+                q = gfAddMod(F, P[i], gfMulMod(F, q, x));
+            }
+        }
+
+        return out;
+    }
+
+    int mid = (lo + hi) / 2;
+    unsigned long long *left = gfTreeCombine(F, g, points, node, 2 * index, lo, mid, c);
+    unsigned long long *right = gfTreeCombine(F, g, points, node, 2 * index + 1, mid, hi, c);
+    unsigned long long *prod = (unsigned long long*)malloc(s * sizeof(unsigned long long));
+
+    if(prod == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // left M_right + right M_left, both of degree below s
+    gfPolyMulNtt(F, g, left, mid - lo - 1, node[2 * index + 1], hi - mid, prod);
+
+    for(int i = 0; i < s; i++) out[i] = prod[i];
+
+    gfPolyMulNtt(F, g, right, hi - mid - 1, node[2 * index], mid - lo, prod);
+
+    for(int i = 0; i < s; i++) out[i] = gfAddMod(F, out[i], prod[i]);
+
+    free(left);
+    free(right);
+    free(prod);
+
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+
+void treeModular(subproductTree* t, const bigInt* f, int df, double bits, int mode, bigInt* out){
+
+    int n = t->numPoints;
+    int len = (df + 1 > n) ? df + 1 : n;
+    unsigned long long h = t->next;
+    unsigned long long *fr = (unsigned long long*)malloc((len + 1) * sizeof(unsigned long long));
+    unsigned long long *r = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    bigInt M;
+
+    if(fr == NULL || r == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&M, 1);
+
+    for(int i = 0; i < n; i++) bigInit(&out[i], 0);
+
+    // the same computation runs modulo primes above 2^61 until their product
+    // covers 2^(bits + 1), and the balanced CRT lift is then exact
+    for(int k = 0; 61.0 * k < bits + 1; k++){
+
+        unsigned long long p, g;
+        unsigned long long **node;
+        int kept = (k < t->numPrimes);
+
+        if(kept){
+
+            p = t->modulus[k];
+            g = t->root[k];
+            node = t->node[k];
+        }
+        else{
+
+            p = nttPrimeBelow(&h, &g);
+            node = (unsigned long long**)calloc(2 * t->numNodes, sizeof(unsigned long long*));
+
+            if(node == NULL){
+
+                printf("\nError allocating memory.");
+                exit(1);
+            }
+
+            gfField F = gfInit(p);
+            long long words = 2 * gfTreeBuild(&F, g, t->points, node, 1, 0, n);
+
+            // products modulo the first primes are kept while they fit the
+            // budget, since every later call on these points starts with them
+            if(k == t->numPrimes && t->words + words <= TREE_CACHE_WORDS){
+
+                t->modulus = (unsigned long long*)realloc(t->modulus, (k + 1) * sizeof(unsigned long long));
+                t->root = (unsigned long long*)realloc(t->root, (k + 1) * sizeof(unsigned long long));
+                t->node = (unsigned long long***)realloc(t->node, (k + 1) * sizeof(unsigned long long**));
+
+                if(t->modulus == NULL || t->root == NULL || t->node == NULL){
+
+                    printf("\nError allocating memory.");
+                    exit(1);
+                }
+
+                t->modulus[k] = p;
+                t->root[k] = g;
+                t->node[k] = node;
+                t->numPrimes++;
+                t->words += words;
+                t->next = h;
+                kept = 1;
+            }
+        }
+
+        gfField F = gfInit(p);
+
+        if(mode == 2){
+
+            for(int i = 0; i < n; i++) fr[i] = gfFromBig(&F, &f[i]);
+
+            unsigned long long *c = gfTreeCombine(&F, g, t->points, node, 1, 0, n, fr);
+
+            for(int i = 0; i < n; i++) r[i] = c[i];
+
+            free(c);
+        }
+        else{
+
+            unsigned long long *rem = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+            int d = df;
+
+            if(rem == NULL){
+
+                printf("\nError allocating memory.");
+                exit(1);
+            }
+
+            if(mode == 1){
+
+                // M' taken from the root product
+                for(int i = 1; i <= n; i++) fr[i - 1] = gfMulMod(&F, node[1][i], gfFromLong(&F, i));
+
+                d = n - 1;
+            }
+            else for(int i = 0; i <= df; i++) fr[i] = gfFromBig(&F, &f[i]);
+
+            gfPolyRemMonic(&F, g, fr, d, node[1], n, NULL, rem);
+            gfTreeEval(&F, g, t->points, node, node + t->numNodes, 1, 0, n, rem, r);
+
+            free(rem);
+        }
+
+        for(int i = 0; i < n; i++) r[i] = gfFromMont(&F, r[i]);
+
+        crtStep(out, n, &M, r, p);
+        bigScale(&M, (long long)p);
+
+        if(!kept){
+
+            for(int i = 0; i < 2 * t->numNodes; i++) free(node[i]);
+
+            free(node);
+        }
+    }
+
+    bigFree(&M);
+    free(fr);
+    free(r);
+}
+
+//-----------------------------------------------------------------------------
+
+subproductTree pTreeCreate(const int* points, int numPoints){
+
+    subproductTree t;
+
+    t.numPoints = (numPoints > 0) ? numPoints : 0;
+    t.points = (int*)malloc((t.numPoints + 1) * sizeof(int));
+    t.numNodes = 4 * (2 * t.numPoints / TREE_LEAF_POINTS + 2);
+    t.numPrimes = 0;
+    t.words = 0;
+    t.next = 1ULL << 30;
+    t.modulus = NULL;
+    t.root = NULL;
+    t.node = NULL;
+    t.weight = NULL;
+
+    if(t.points == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&t.scale, 0);
+
+    for(int i = 0; i < t.numPoints; i++) t.points[i] = points[i];
+
+    return t;
+}
+
+//-----------------------------------------------------------------------------
+
+term* pEvalMulti(polynomial p, subproductTree* tree){
+
+    int n = tree->numPoints, df;
+    term *values = (term*)malloc((n + 1) * sizeof(term));
+    bigInt *out = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+    if(values == NULL || out == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInt *f = bigsFromPoly(p, &df);
+
+    if(df < 0){
+
+        for(int i = 0; i < n; i++) values[i] = setTerms(0, 0);
+    }
+    else if(n > 0){
+
+        double logF = 0, logX = 0;
+
+        for(int i = 0; i <= df; i++){
+
+            if(f[i].sign != 0 && bigLog2(&f[i]) > logF) logF = bigLog2(&f[i]);
+        }
+
+        for(int i = 0; i < n; i++){
+
+            if(log2(fabs((double)tree->points[i])) > logX) logX = log2(fabs((double)tree->points[i]));
+        }
+
+        // |f(x)| <= (df + 1) max |f_i| max(1, |x|)^df
+        treeModular(tree, f, df, log2(df + 1.0) + logF + df * logX + 1, 0, out);
+
+        for(int i = 0; i < n; i++) values[i] = termFromBig(&out[i], 0);
+    }
+
+    bigsFree(f, df + 1);
+    free(out);
+
+    return values;
+}
+
+//-----------------------------------------------------------------------------
+
+term pInterpolate(subproductTree* tree, const term* values, polynomial* f){
+
+    int n = tree->numPoints;
+
+    *f = pCreate(0);
+
+    if(n == 0) return setTerms(0, 0);
+
+    double logSpan = 0, logX = 0;
+
+    for(int i = 0; i < n; i++){
+
+        logSpan += log2(1.0 + fabs((double)tree->points[i]));
+
+        if(log2(fabs((double)tree->points[i])) > logX) logX = log2(fabs((double)tree->points[i]));
+    }
+
+    // Lagrange weights D / M'(x_i), with D the lcm of the M'(x_i), depend only
+    // on the points and are kept in the tree for later calls
+    if(tree->weight == NULL){
+
+        bigInt *w = (bigInt*)malloc(n * sizeof(bigInt));
+
+        if(w == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        // |M'(x_i)| is a product of n - 1 distances, each at most 2 max |x_j|
+        treeModular(tree, NULL, n - 1, (n - 1) * (1 + logX) + 1, 1, w);
+
+        for(int i = 0; i < n; i++){
+
+            if(w[i].sign == 0){
+
+                bigsFree(w, n);
+                return setTerms(0, 0);
+            }
+        }
+
+        bigLcmRange(w, 0, n, &tree->scale);
+
+        for(int i = 0; i < n; i++){
+
+            bigInt u, r;
+
+            bigInit(&u, 0);
+            bigInit(&r, 0);
+            bigDivMod(&tree->scale, &w[i], &u, &r);
+            bigFree(&r);
+            bigFree(&w[i]);
+
+            w[i] = u;
+        }
+
+        tree->weight = w;
+    }
+
+    bigInt *c = bigsCreate(n);
+    bigInt *F = (bigInt*)malloc(n * sizeof(bigInt));
+    bigInt D, g;
+    double logC = 0;
+
+    if(F == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i < n; i++){
+
+        bigInt v;
+
+        termToBig(values[i], &v);
+        bigAddProduct(&c[i], &v, &tree->weight[i]);
+        bigFree(&v);
+
+        if(c[i].sign != 0 && bigLog2(&c[i]) > logC) logC = bigLog2(&c[i]);
+    }
+
+    // every M / (x - x_i) has coefficients below the product of 1 + |x_j|
+    treeModular(tree, c, n - 1, log2((double)n) + logC + logSpan + 1, 2, F);
+
+    bigsFree(c, n);
+    bigInit(&D, 0);
+    bigInit(&g, 0);
+    bigAdd(&D, &tree->scale);
+    bigAdd(&g, &tree->scale);
+
+    for(int i = 0; i < n && !(g.size == 1 && g.limb[0] == 1); i++){
+
+        if(F[i].sign != 0) bigGcd(&g, &F[i], &g);
+    }
+
+    if(!(g.size == 1 && g.limb[0] == 1)){
+
+        bigInt r;
+
+        bigInit(&r, 0);
+        bigDivMod(&D, &g, &D, &r);
+
+        for(int i = 0; i < n; i++) bigDivMod(&F[i], &g, &F[i], &r);
+
+        bigFree(&r);
+    }
+
+    bigFree(&g);
+
+    int deg = n - 1;
+
+    while(deg >= 0 && F[deg].sign == 0) bigFree(&F[deg--]);
+
+    free(f->terms);
+    *f = pCreate(deg + 1);
+
+    for(int i = 0; i <= deg; i++) f->terms[i] = termFromBig(&F[deg - i], deg - i);
+
+    free(F);
+
+    return termFromBig(&D, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long gfResultant(const gfField* F, unsigned long long* a, int da, unsigned long long* b, int db){
+
+    unsigned long long res = F->one;
+
+    da = mpTrim(a, da);
+    db = mpTrim(b, db);
+
+    if(da < 0 || db < 0) return 0;
+
+    // res(a, b) = (-1)^(da db) lc(b)^(da - dr) res(b, a mod b), with a and b
+    // trading buffers at every step
+    while(db > 0){
+
+        int dr = gfPolyDivRem(F, a, da, b, db, NULL);
+
+        if(dr < 0) return 0;
+
+        if((da & 1) && (db & 1)) res = gfSubMod(F, 0, res);
+
+        res = gfMulMod(F, res, gfPowMod(F, b[db], da - dr));
+
+        unsigned long long *t = a;
+
+        a = b;
+        b = t;
+        da = db;
+        db = dr;
+    }
+
+    return gfMulMod(F, res, gfPowMod(F, b[0], da));
+}
+
+//-----------------------------------------------------------------------------
+
+void bigResultantModular(const bigInt* A, int m, const bigInt* B, int n, int discriminant, bigInt* r){
+
+    int size = ((m > n) ? m : n) + 1;
+    unsigned long long h = 1ULL << 30, g;
+    unsigned long long *a = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    unsigned long long *b = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    double logA = 0, logB = 0;
+    bigInt M;
+
+    if(a == NULL || b == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= m; i++){
+
+        if(A[i].sign != 0 && bigLog2(&A[i]) > logA) logA = bigLog2(&A[i]);
+    }
+
+    for(int i = 0; i <= n; i++){
+
+        if(B[i].sign != 0 && bigLog2(&B[i]) > logB) logB = bigLog2(&B[i]);
+    }
+
+    // Hadamard: |res| <= |A|^n |B|^m, and the discriminant is res / lc(A)
+    double bits = n * (logA + 0.5 * log2(m + 1.0)) + m * (logB + 0.5 * log2(n + 1.0)) + 1;
+
+    bigInit(r, 0);
+    bigInit(&M, 1);
+
+    // a prime that leaves the value unchanged ends the search early, which is
+    // wrong only if the true value and the partial one agree modulo a 61-bit
+    // prime; the bound stops it otherwise
+    for(int k = 0; ; ){
+
+        unsigned long long p = nttPrimeBelow(&h, &g);
+        gfField F = gfInit(p);
+
+        if(bigModSmall(&A[m], p) == 0 || bigModSmall(&B[n], p) == 0) continue;
+
+        for(int i = 0; i <= m; i++) a[i] = gfFromBig(&F, &A[i]);
+        for(int i = 0; i <= n; i++) b[i] = gfFromBig(&F, &B[i]);
+
+        unsigned long long lc = a[m];
+        unsigned long long v = gfResultant(&F, a, m, b, n);
+
+        if(discriminant){
+
+            v = gfMulMod(&F, v, gfPowMod(&F, lc, p - 2));
+
+            // (-1)^(m (m - 1) / 2)
+            if(m % 4 == 2 || m % 4 == 3) v = gfSubMod(&F, 0, v);
+        }
+
+        v = gfFromMont(&F, v);
+
+        int stable = crtStep(r, 1, &M, &v, p);
+
+        bigScale(&M, (long long)p);
+        k++;
+
+        if((stable && k > 1) || 61.0 * k >= bits + 1) break;
+    }
+
+    bigFree(&M);
+    free(a);
+    free(b);
+}
+
+//-----------------------------------------------------------------------------
+
+bigInt* bigPolyDivExact(const bigInt* A, int m, const bigInt* B, int n){
+
+    bigInt *T = bigsCreate(m + 1);
+    bigInt *Q = (bigInt*)malloc((m - n + 2) * sizeof(bigInt));
+    bigInt D, rem;
+    int exact = 1;
+
+    if(Q == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= m; i++) bigAdd(&T[i], &A[i]);
+
+    bigPolyDivClassical(T, m, B, n, Q, &D);
+
+    for(int i = 0; i < n && exact; i++) exact = (T[i].sign == 0);
+
+    bigInit(&rem, 0);
+
+    // D A = B Q, so the quotient is Q / D when the remainder vanishes
+    for(int i = 0; i <= m - n && exact; i++) bigDivMod(&Q[i], &D, &Q[i], &rem);
+
+    bigsFree(T, m + 1);
+    bigFree(&D);
+    bigFree(&rem);
+
+    if(exact) return Q;
+
+    bigsFree(Q, m - n + 1);
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+int bigPolyGcd(const bigInt* A, int m, const bigInt* B, int n, bigInt* G){
+
+    int size = ((m > n) ? m : n) + 1;
+    int dg = (m < n) ? m : n, live = 0;
+    unsigned long long h = 1ULL << 30, g;
+    unsigned long long *a = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    unsigned long long *b = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    unsigned long long *r = (unsigned long long*)malloc(size * sizeof(unsigned long long));
+    bigInt lc, M, c, rem;
+
+    if(a == NULL || b == NULL || r == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    bigInit(&lc, 0);
+    bigInit(&M, 1);
+    bigInit(&rem, 0);
+
+    // gcd(A, 0) is A made primitive with a positive leading coefficient
+    if(n < 0){
+
+        dg = m;
+        bigInit(&c, 0);
+
+        for(int i = 0; i <= m; i++) bigGcd(&c, &A[i], &c);
+
+        c.sign = A[m].sign;
+
+        for(int i = 0; i <= m; i++){
+
+            bigInit(&G[i], 0);
+            bigDivMod(&A[i], &c, &G[i], &rem);
+        }
+
+        bigFree(&c);
+    }
+    else bigGcd(&A[m], &B[n], &lc);
+
+    // gcd images modulo word primes, scaled to lc = gcd(lc(A), lc(B)), are
+    // joined by CRT until stable; images of higher degree than the lowest seen
+    // come from unlucky primes and are skipped
+    while(n >= 0){
+
+        unsigned long long p = nttPrimeBelow(&h, &g);
+        gfField F = gfInit(p);
+
+        if(bigModSmall(&A[m], p) == 0 || bigModSmall(&B[n], p) == 0) continue;
+
+        for(int i = 0; i <= m; i++) a[i] = gfFromBig(&F, &A[i]);
+        for(int i = 0; i <= n; i++) b[i] = gfFromBig(&F, &B[i]);
+
+        int dp = gfPolyGcd(&F, a, m, b, n, r);
+
+        if(dp > dg) continue;
+
+        if(dp < dg || live == 0){
+
+            for(int i = 0; i < live; i++) bigFree(&G[i]);
+
+            dg = dp;
+            live = dg + 1;
+            bigFree(&M);
+            bigInit(&M, 1);
+
+            for(int i = 0; i <= dg; i++) bigInit(&G[i], 0);
+        }
+
+        if(dg == 0){
+
+            bigFree(&G[0]);
+            bigInit(&G[0], 1);
+            break;
+        }
+
+        unsigned long long l = gfFromBig(&F, &lc);
+
+        for(int i = 0; i <= dg; i++) r[i] = gfFromMont(&F, gfMulMod(&F, r[i], l));
+
+        int stable = crtStep(G, dg + 1, &M, r, p);
+
+        bigScale(&M, (long long)p);
+
+        if(!stable) continue;
+
+        // a stable image is the gcd once its primitive part divides both
+        bigInt *H = bigsCreate(dg + 1);
+
+        bigInit(&c, 0);
+
+        for(int i = 0; i <= dg; i++) bigGcd(&c, &G[i], &c);
+        for(int i = 0; i <= dg; i++) bigDivMod(&G[i], &c, &H[i], &rem);
+
+        bigFree(&c);
+
+        bigInt *QA = bigPolyDivExact(A, m, H, dg);
+        bigInt *QB = (QA != NULL) ? bigPolyDivExact(B, n, H, dg) : NULL;
+
+        if(QA != NULL) bigsFree(QA, m - dg + 1);
+
+        if(QB != NULL){
+
+            bigsFree(QB, n - dg + 1);
+
+            for(int i = 0; i <= dg; i++){
+
+                bigFree(&G[i]);
+                G[i] = H[i];
+            }
+
+            free(H);
+            break;
+        }
+
+        bigsFree(H, dg + 1);
+    }
+
+    bigFree(&lc);
+    bigFree(&M);
+    bigFree(&rem);
+    free(a);
+    free(b);
+    free(r);
+
+    return dg;
+}
+
+//-----------------------------------------------------------------------------
+
+int bigPolyDerivative(const bigInt* A, int m, bigInt* D){
+
+    for(int i = 1; i <= m; i++){
+
+        bigInit(&D[i - 1], 0);
+        bigAdd(&D[i - 1], &A[i]);
+        bigScale(&D[i - 1], i);
+    }
+
+    return m - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial bigsToPoly(bigInt* c, int deg){
+
+    polynomial p = pCreate(deg + 1);
+
+    for(int i = 0; i <= deg; i++) p.terms[deg - i] = termFromBig(&c[i], i);
+
+    free(c);
+
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigsPrimitive(bigInt* c, int deg){
+
+    if(deg < 0) return;
+
+    bigInt g, rem;
+
+    bigInit(&g, 0);
+    bigInit(&rem, 0);
+
+    for(int i = 0; i <= deg; i++) bigGcd(&g, &c[i], &g);
+
+    g.sign = c[deg].sign;
+
+    for(int i = 0; i <= deg; i++) bigDivMod(&c[i], &g, &c[i], &rem);
+
+    bigFree(&g);
+    bigFree(&rem);
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial* bigSquareFree(polynomial p, int* numParts){
+
+    int deg = 0;
+    bigInt *f = bigsFromPoly(p, &deg);
+    polynomial *parts = (polynomial*)malloc((deg + 2) * sizeof(polynomial));
+    bigInt *d = (bigInt*)malloc((deg + 1) * sizeof(bigInt));
+    bigInt *a = (bigInt*)malloc((deg + 1) * sizeof(bigInt));
+
+    if(parts == NULL || d == NULL || a == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    *numParts = 0;
+
+    if(deg <= 0){
+
+        bigsPrimitive(f, deg);
+
+        parts[(*numParts)++] = bigsToPoly(f, deg);
+
+        free(d);
+        free(a);
+
+        return parts;
+    }
+
+    // Yun: with a = gcd(f, f'), b = f / a and c = f' / a, each
+    // a_i = gcd(b, c - b') is the product of the roots of multiplicity i
+    int dd = bigPolyDerivative(f, deg, d);
+    int da = bigPolyGcd(f, deg, d, dd, a);
+    int db = deg - da, dc = dd - da;
+    bigInt *b = bigPolyDivExact(f, deg, a, da);
+    bigInt *c = bigPolyDivExact(d, dd, a, da);
+
+    bigsFree(f, deg + 1);
+    bigsFree(d, dd + 1);
+    bigsFree(a, da + 1);
+
+    while(db > 0){
+
+        bigInt *t = (bigInt*)malloc((db + 1) * sizeof(bigInt));
+
+        if(t == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        int dt = bigPolyDerivative(b, db, t);
+        int len = (dc > dt) ? dc : dt;
+
+        d = bigsCreate(len + 1);
+
+        for(int i = 0; i <= len; i++){
+
+            if(i <= dc) bigAdd(&d[i], &c[i]);
+
+            if(i <= dt){
+
+                t[i].sign = -t[i].sign;
+                bigAdd(&d[i], &t[i]);
+            }
+        }
+
+        bigsFree(t, dt + 1);
+
+        dd = len;
+
+        while(dd >= 0 && d[dd].sign == 0) dd--;
+
+        a = (bigInt*)malloc((db + 1) * sizeof(bigInt));
+
+        if(a == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        da = bigPolyGcd(b, db, d, dd, a);
+
+        bigInt *nb = bigPolyDivExact(b, db, a, da);
+        bigInt *nc = (dd >= da) ? bigPolyDivExact(d, dd, a, da) : NULL;
+
+        bigsFree(b, db + 1);
+        bigsFree(c, dc + 1);
+        bigsFree(d, len + 1);
+
+        parts[(*numParts)++] = bigsToPoly(a, da);
+
+        b = nb;
+        c = nc;
+        db -= da;
+        dc = dd - da;
+    }
+
+    bigsFree(b, db + 1);
+
+    if(c != NULL) bigsFree(c, dc + 1);
+
+    return parts;
+}
+
+//-----------------------------------------------------------------------------
+
+term pResultant(polynomial a, polynomial b){
+
+    int m, n;
+    bigInt *A = bigsFromPoly(a, &m), *B = bigsFromPoly(b, &n);
+    bigInt r;
+
+    if(m < 0 || n < 0) bigInit(&r, 0);
+    else bigResultantModular(A, m, B, n, 0, &r);
+
+    bigsFree(A, m + 1);
+    bigsFree(B, n + 1);
+
+    return termFromBig(&r, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+term pDiscriminant(polynomial p){
+
+    int m;
+    bigInt *A = bigsFromPoly(p, &m);
+    bigInt r;
+
+    if(m < 1) bigInit(&r, 0);
+    else{
+
+        bigInt *D = (bigInt*)malloc(m * sizeof(bigInt));
+
+        if(D == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        bigPolyDerivative(A, m, D);
+        bigResultantModular(A, m, D, m - 1, 1, &r);
+        bigsFree(D, m);
+    }
+
+    bigsFree(A, m + 1);
+
+    return termFromBig(&r, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+qPolynomial qCreate(int numTerms){
+
+    qPolynomial q;
+
+    q.num = pCreate(numTerms);
+    q.den = (int*)malloc((numTerms + 1) * sizeof(int));
+
+    if(q.den == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i < numTerms; i++) q.den[i] = 1;
+
+    return q;
+}
+
+//-----------------------------------------------------------------------------
+
+term qPrimitive(qPolynomial* q, term* den){
+
+    term *t = q->num.terms;
+    int n = q->num.numTerms, lead = -1, deferred = 0;
+    unsigned long long g = 0;
+    bigInt L;
+
+    bigInit(&L, 1);
+
+    // one sweep: each a_i / b_i is reduced, which makes the content
+    // gcd(a_i) / lcm(b_i); numerators past 2^64 wait for g to be seeded
+    for(int i = 0; i < n; i++){
+
+        long long b = q->den[i];
+
+        if(t[i].big == NULL && t[i].coefficient == 0) continue;
+
+        if(lead < 0 || t[i].exponent > t[lead].exponent) lead = i;
+
+        unsigned long long a = (t[i].big != NULL) ? bigModSmall(t[i].big, (unsigned long long)llabs(b)) : (unsigned long long)llabs(t[i].coefficient);
+        long long r = (long long)ullGcd(a, (unsigned long long)llabs(b));
+
+        if(b < 0) r = -r;
+
+        if(r != 1){
+
+            if(t[i].big != NULL){
+
+                bigInt x = *t[i].big;
+
+                bigDivSmall(&x, r);
+                free(t[i].big);
+                t[i] = termFromBig(&x, t[i].exponent);
+            }
+            else t[i].coefficient /= r;
+
+            b /= r;
+        }
+
+        q->den[i] = (int)b;
+
+        if(t[i].big == NULL) g = ullGcd(g, (unsigned long long)llabs(t[i].coefficient));
+        else if(t[i].big->size == 1) g = ullGcd(g, t[i].big->limb[0]);
+        else if(g > 1) g = ullGcd(g, bigModSmall(t[i].big, g));
+        else if(g == 0) deferred = 1;
+
+        unsigned long long m = bigModSmall(&L, (unsigned long long)b);
+
+        if(m != 0) bigScale(&L, b / (long long)ullGcd(m, (unsigned long long)b));
+    }
+
+    for(int i = 0; i < n && deferred && g > 1; i++){
+
+        if(t[i].big != NULL) g = ullGcd(g, bigModSmall(t[i].big, g));
+    }
+
+    if(lead < 0){
+
+        bigFree(&L);
+        *den = setTerms(1, 0);
+
+        return setTerms(0, 0);
+    }
+
+    if(g == 0 || g > LLONG_MAX) g = 1;
+
+    long long c = (t[lead].big != NULL ? t[lead].big->sign : t[lead].coefficient) < 0 ? -(long long)g : (long long)g;
+
+    // a_i / b_i = (c / L) (a_i / c) (L / b_i), rewritten over the same terms
+    for(int i = 0; i < n; i++){
+
+        bigInt x, s;
+
+        termToBig(t[i], &x);
+        termFree(&t[i]);
+
+        if(x.sign != 0){
+
+            bigDivSmall(&x, c);
+            bigInit(&s, 0);
+            bigAdd(&s, &L);
+            bigDivSmall(&s, q->den[i]);
+            bigMul(&x, &s);
+            bigFree(&s);
+        }
+
+        t[i] = termFromBig(&x, t[i].exponent);
+        q->den[i] = 1;
+    }
+
+    *den = termFromBig(&L, 0);
+
+    return termFromInt128(c, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+int vcaVariations(const bigInt* c, int deg){
+
+    int variations = 0, last = 0;
+
+    for(int i = 0; i <= deg; i++){
+
+        if(c[i].sign == 0) continue;
+        if(last != 0 && c[i].sign != last) variations++;
+
+        last = c[i].sign;
+    }
+
+    return variations;
+}
+
+//-----------------------------------------------------------------------------
+
+long long vcaLowerBound(const bigInt* c, int deg){
+
+    // Kioustelidis' bound on the positive roots of x^deg p(1/x), inverted
+    int lead = 0;
+    double bound = -HUGE_VAL;
+
+    while(lead < deg && c[lead].sign == 0) lead++;
+
+    double top = bigLog2(&c[lead]);
+
+    for(int i = lead + 1; i <= deg; i++){
+
+        if(c[i].sign == 0 || c[i].sign == c[lead].sign) continue;
+
+        double b = (bigLog2(&c[i]) - top) / (i - lead);
+
+        if(b > bound) bound = b;
+    }
+
+    if(bound == -HUGE_VAL) return 0;
+
+    double lower = -(bound + 1.0) - 1e-9;
+
+    if(lower < 0.0) return 0;
+    if(lower > 62.0) lower = 62.0;
+
+    return (long long)exp2(lower);
+}
+
+//-----------------------------------------------------------------------------
+
+void vcaRecord(rootInterval** list, int* count, int* cap, long long ln, long long ld, long long rn, long long rd){
+
+    if(*count == *cap){
+
+        *cap = (*cap == 0) ? 8 : 2 * *cap;
+        rootInterval *grown = (rootInterval*)realloc(*list, *cap * sizeof(rootInterval));
+
+        if(grown == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        *list = grown;
+    }
+
+    long long gl = (long long)ullGcd(llabs(ln), ld);
+    long long gr = (long long)ullGcd(llabs(rn), rd);
+
+    if(gl > 1){
+
+        ln /= gl;
+        ld /= gl;
+    }
+
+    if(gr > 1){
+
+        rn /= gr;
+        rd /= gr;
+    }
+
+    if((__int128)ln * rd > (__int128)rn * ld){
+
+        long long tn = ln, td = ld;
+
+        ln = rn;
+        ld = rd;
+        rn = tn;
+        rd = td;
+    }
+
+    (*list)[*count].leftNum = ln;
+    (*list)[*count].leftDen = ld;
+    (*list)[*count].rightNum = rn;
+    (*list)[*count].rightDen = rd;
+    (*count)++;
+}
+
+//-----------------------------------------------------------------------------
+
+int vcaPositive(const bigInt* f, int deg, long long bound, int negate, rootInterval** list, int* count, int* cap){
+
+    int size = 1, capacity = 16, ok = 1;
+    vcaNode *stack = (vcaNode*)malloc(capacity * sizeof(vcaNode));
+
+    if(stack == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    stack[0].deg = deg;
+    stack[0].c = (bigInt*)malloc((deg + 1) * sizeof(bigInt));
+
+    if(stack[0].c == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= deg; i++){
+
+        bigInit(&stack[0].c[i], 0);
+        bigAdd(&stack[0].c[i], &f[i]);
+
+        if(negate && i % 2) stack[0].c[i].sign = -stack[0].c[i].sign;
+    }
+
+    // M(x) = (m0 x + m1) / (m2 x + m3) maps the roots of the node in (0, inf)
+    // onto roots of f in (M(0), M(inf))
+    stack[0].m[0] = 1;
+    stack[0].m[1] = 0;
+    stack[0].m[2] = 0;
+    stack[0].m[3] = 1;
+
+    while(size > 0){
+
+        vcaNode node = stack[--size];
+        long long *m = node.m;
+        int variations = 0;
+
+        for(int pass = 0; pass < 2 && ok; pass++){
+
+            if(node.c[0].sign == 0){
+
+                long long rn = negate ? -m[1] : m[1];
+
+                vcaRecord(list, count, cap, rn, m[3], rn, m[3]);
+                bigFree(&node.c[0]);
+
+                for(int i = 0; i < node.deg; i++) node.c[i] = node.c[i + 1];
+
+                node.deg--;
+            }
+
+            variations = (node.deg > 0) ? vcaVariations(node.c, node.deg) : 0;
+
+            if(variations <= 1 || pass == 1) break;
+
+            // Jumps straight to the lower bound b of the positive roots,
+            // scaling x -> bx first when b is large: p(x) <- p(b(x + 1))
+            long long b = vcaLowerBound(node.c, node.deg);
+
+            if(b < 1) break;
+
+            if(b > 16){
+
+                for(int i = 1; i <= node.deg; i++){
+
+                    bigScale(&node.c[i], b);
+
+                    for(int j = 1; j < i; j++) bigScale(&node.c[i], b);
+                }
+
+                if(__builtin_mul_overflow(m[0], b, &m[0]) || __builtin_mul_overflow(m[2], b, &m[2])) ok = 0;
+
+                b = 1;
+            }
+
+            bigTaylorShift(node.c, node.deg, b);
+
+            long long t0 = 0, t2 = 0;
+
+            if(__builtin_mul_overflow(m[0], b, &t0) || __builtin_add_overflow(m[1], t0, &m[1])) ok = 0;
+            if(__builtin_mul_overflow(m[2], b, &t2) || __builtin_add_overflow(m[3], t2, &m[3])) ok = 0;
+        }
+
+        if(ok && variations == 1){
+
+            long long ln = m[1], ld = m[3], rn = m[0], rd = m[2];
+
+            if(rd == 0){
+
+                rn = bound;
+                rd = 1;
+            }
+
+            if(negate){
+
+                ln = -ln;
+                rn = -rn;
+            }
+
+            vcaRecord(list, count, cap, ln, ld, rn, rd);
+        }
+
+        if(ok && variations > 1){
+
+            if(size + 2 > capacity){
+
+                capacity *= 2;
+                vcaNode *grown = (vcaNode*)realloc(stack, capacity * sizeof(vcaNode));
+
+                if(grown == NULL){
+
+                    printf("\nError allocating memory.");
+                    exit(1);
+                }
+
+                stack = grown;
+            }
+
+            // (1, inf): x -> x + 1;  (0, 1): x -> 1 / (x + 1)
+            vcaNode right = node, left = node;
+
+            left.c = (bigInt*)malloc((node.deg + 1) * sizeof(bigInt));
+
+            if(left.c == NULL){
+
+                printf("\nError allocating memory.");
+                exit(1);
+            }
+
+            for(int i = 0; i <= node.deg; i++){
+
+                bigInit(&left.c[i], 0);
+                bigAddMul(&left.c[i], &node.c[node.deg - i], 1);
+            }
+
+            bigTaylorShift(right.c, right.deg, 1);
+            bigTaylorShift(left.c, left.deg, 1);
+
+            if(__builtin_add_overflow(m[0], m[1], &right.m[1]) || __builtin_add_overflow(m[2], m[3], &right.m[3])) ok = 0;
+
+            left.m[0] = m[1];
+            left.m[1] = right.m[1];
+            left.m[2] = m[3];
+            left.m[3] = right.m[3];
+
+            // x = 1 is a root of both halves; the right one records it
+            if(left.c[0].sign == 0){
+
+                bigFree(&left.c[0]);
+
+                for(int i = 0; i < left.deg; i++) left.c[i] = left.c[i + 1];
+
+                left.deg--;
+            }
+
+            stack[size++] = left;
+            stack[size++] = right;
+
+            continue;
+        }
+
+        for(int i = 0; i <= node.deg; i++) bigFree(&node.c[i]);
+
+        free(node.c);
+    }
+
+    free(stack);
+
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+
+bigInt* vcaSquareFree(polynomial p, int* deg){
+
+    int n = 0, dg = 0;
+    long long *f = zpFromPoly(p, &n);
+    bigInt *c;
+
+    if(f != NULL && n >= 1){
+
+        long long *d = (long long*)calloc(n + 1, sizeof(long long));
+        long long *g = (long long*)calloc(n + 2, sizeof(long long));
+        long long *q = (long long*)calloc(n + 1, sizeof(long long));
+
+        if(d == NULL || g == NULL || q == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        int dd = zpDerivative(f, n, d);
+
+        dg = zpGcd(f, n, d, dd, g);
+
+        if(dg > 0 && zpDivExact(f, n, g, dg, q)){
+
+            for(int i = 0; i <= n - dg; i++) f[i] = q[i];
+
+            n -= dg;
+        }
+
+        zpPrimitive(f, n);
+
+        free(d);
+        free(g);
+        free(q);
+    }
+
+    if(f != NULL && dg != -2){
+
+        c = (bigInt*)malloc((n + 2) * sizeof(bigInt));
+
+        if(c == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for(int i = 0; i <= n; i++) bigInit(&c[i], f[i]);
+
+        free(f);
+
+        *deg = n;
+
+        return c;
+    }
+
+    free(f);
+
+    // heap coefficients, or the word-size gcd overflowed
+    c = bigsFromPoly(p, &n);
+
+    if(n >= 1){
+
+        bigInt *d = (bigInt*)malloc(n * sizeof(bigInt));
+        bigInt *g = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+        if(d == NULL || g == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        int dd = bigPolyDerivative(c, n, d);
+
+        dg = bigPolyGcd(c, n, d, dd, g);
+
+        if(dg > 0){
+
+            bigInt *q = bigPolyDivExact(c, n, g, dg);
+
+            bigsFree(c, n + 1);
+            c = q;
+            n -= dg;
+        }
+
+        bigsFree(d, dd + 1);
+        bigsFree(g, dg + 1);
+    }
+
+    bigsPrimitive(c, n);
+
+    *deg = n;
+
+    return c;
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpInterval(const void* a, const void* b){
+
+    const rootInterval *x = (const rootInterval*)a;
+    const rootInterval *y = (const rootInterval*)b;
+    __int128 lhs = (__int128)x->leftNum * y->leftDen;
+    __int128 rhs = (__int128)y->leftNum * x->leftDen;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+rootInterval* pRealRoots(polynomial p, int* numRoots){
+
+    int n = 0, count = 0, cap = 0;
+    bigInt *f = vcaSquareFree(p, &n);
+    rootInterval *list = NULL;
+    bigInt q, rem;
+
+    *numRoots = 0;
+
+    if(n < 1){
+
+        bigsFree(f, n + 1);
+        return NULL;
+    }
+
+    if(f[0].sign == 0){
+
+        vcaRecord(&list, &count, &cap, 0, 1, 0, 1);
+        bigFree(&f[0]);
+
+        for(int i = 0; i < n; i++) f[i] = f[i + 1];
+
+        n--;
+    }
+
+    // Cauchy's bound closes the interval of the largest root
+    long long bound = 1;
+
+    bigInit(&q, 0);
+    bigInit(&rem, 0);
+
+    for(int i = 0; i < n && bound > 0; i++){
+
+        bigDivMod(&f[i], &f[n], &q, &rem);
+
+        if(q.size > 1 || (q.size == 1 && q.limb[0] > LLONG_MAX - 2)) bound = 0;
+        else if(q.size == 1 && (long long)q.limb[0] + 2 > bound) bound = (long long)q.limb[0] + 2;
+        else if(bound < 2) bound = 2;
+    }
+
+    // past a long long, Fujiwara's bound 2 max |f_i / f_n|^(1/(n-i)) is
+    // used instead, with a margin for the rounding of pow()
+    if(bound == 0){
+
+        long double b = 1;
+
+        for(int i = 0; i < n; i++){
+
+            bigDivMod(&f[i], &f[n], &q, &rem);
+
+            long double root = powl(fabsl((long double)bigToDouble(&q)) + 1, 1.0L / (n - i));
+
+            if(root > b) b = root;
+        }
+
+        b = 2 * b * (1 + 1e-9L) + 1;
+
+        if(b < 4e18L) bound = (long long)b;
+    }
+
+    bigFree(&q);
+    bigFree(&rem);
+
+    int ok = (n < 1) || (bound > 0 && vcaPositive(f, n, bound, 0, &list, &count, &cap) && vcaPositive(f, n, bound, 1, &list, &count, &cap));
+
+    bigsFree(f, n + 1);
+
+    if(!ok){
+
+        free(list);
+        *numRoots = -1;
+        return NULL;
+    }
+
+    if(count > 1) qsort(list, count, sizeof(rootInterval), cmpInterval);
+
+    *numRoots = count;
+
+    return list;
+}
+
+//-----------------------------------------------------------------------------
+
+int pRefineRoot(polynomial p, rootInterval* r, double width){
+
+    int n = 0;
+    bigInt *f = vcaSquareFree(p, &n);
+    bigInt *d = (bigInt*)malloc((n + 1) * sizeof(bigInt));
+
+    if(d == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int dd = (n > 0) ? bigPolyDerivative(f, n, d) : -1;
+    int sLeft = (n > 0) ? bigPolySign(f, n, r->leftNum, r->leftDen) : 0;
+    int reached = 0;
+
+    // At a left end that is itself a (simple) root, p takes the sign of p'
+    if(sLeft == 0 && dd >= 0) sLeft = bigPolySign(d, dd, r->leftNum, r->leftDen);
+
+    while(n > 0){
+
+        long double w = (long double)r->rightNum / r->rightDen - (long double)r->leftNum / r->leftDen;
+
+        if(w <= width){
+
+            reached = 1;
+            break;
+        }
+
+        __int128 wideNum = (__int128)r->leftNum * r->rightDen + (__int128)r->rightNum * r->leftDen;
+        __int128 wideDen = (__int128)r->leftDen * r->rightDen * 2;
+        __int128 x = (wideNum < 0) ? -wideNum : wideNum, y = wideDen;
+
+        while(y != 0){
+
+            __int128 t = x % y;
+
+            x = y;
+            y = t;
+        }
+
+        wideNum /= x;
+        wideDen /= x;
+
+        if(wideDen > LLONG_MAX || wideNum > LLONG_MAX || wideNum < -LLONG_MAX) break;
+
+        long long num = (long long)wideNum, den = (long long)wideDen;
+
+        int sMid = bigPolySign(f, n, num, den);
+
+        if(sMid == 0){
+
+            r->leftNum = r->rightNum = num;
+            r->leftDen = r->rightDen = den;
+        }
+        else if(sMid == sLeft){
+
+            r->leftNum = num;
+            r->leftDen = den;
+        }
+        else{
+
+            r->rightNum = num;
+            r->rightDen = den;
+        }
+    }
+
+    bigsFree(f, n + 1);
+    bigsFree(d, dd + 1);
+
+    return reached;
+}
+
+//-----------------------------------------------------------------------------
+
+int isCyclotomicProduct(polynomial p){
+
+    int n = 0;
+    long long *c = zpFromPoly(p, &n);
+
+    // the Graeffe test runs on 64-bit coefficients, so heap ones are rejected
+    if(c == NULL) return 0;
+
+    if(n < 1 || (c[n] != 1 && c[n] != -1) || (c[0] != 1 && c[0] != -1)){
+
+        free(c);
+        return 0;
+    }
+
+    for(int i = 0; i <= n; i++){
+
+        if(c[i] != c[0] * c[n] * c[n-i]){
+
+            free(c);
+            return 0;
+        }
+    }
+
+    gfField F = gfInit(CYCLOTOMIC_PRIME);
+    unsigned long long *f = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+    unsigned long long *g = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+    unsigned long long *half = (unsigned long long*)calloc(n / 2 + 1, sizeof(unsigned long long));
+    unsigned long long *even = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+    unsigned long long *odd = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+
+    if(f == NULL || g == NULL || half == NULL || even == NULL || odd == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= n; i++){
+
+        long long v = c[i] * c[n];
+
+        f[i] = gfToMont(&F, (v < 0) ? CYCLOTOMIC_PRIME - (unsigned long long)(-v) : (unsigned long long)v);
+    }
+
+    int steps = 2;
+    int cyclotomic = 0;
+
+    for(long long bound = 2LL * n * n; bound > 1; bound >>= 1) steps++;
+
+    for(int s = 0; s < steps && !cyclotomic; s++){
+
+        for(int i = 0; 2 * i <= n; i++) half[i] = f[2*i];
+
+        gfPolyMul(&F, half, n / 2, half, n / 2, even);
+
+        for(int i = 0; 2 * i + 1 <= n; i++) half[i] = f[2*i+1];
+
+        gfPolyMul(&F, half, (n - 1) / 2, half, (n - 1) / 2, odd);
+
+        for(int i = 0; i <= n; i++){
+
+            unsigned long long e = (i <= 2 * (n / 2)) ? even[i] : 0;
+            unsigned long long o = (i >= 1 && i - 1 <= 2 * ((n - 1) / 2)) ? odd[i-1] : 0;
+
+            g[i] = gfSubMod(&F, e, o);
+
+            if(n % 2 == 1) g[i] = gfSubMod(&F, 0, g[i]);
+        }
+
+        cyclotomic = 1;
+
+        for(int i = 0; i <= n; i++){
+
+            if(g[i] != f[i]) cyclotomic = 0;
+
+            f[i] = g[i];
+        }
+    }
+
+    free(c);
+    free(f);
+    free(g);
+    free(half);
+    free(even);
+    free(odd);
+
+    return cyclotomic;
+}
+
+//-----------------------------------------------------------------------------
+
+int* cyclotomicCandidates(int n, int* count){
+
+    long long bound = 2LL * n * n;
+
+    if(bound >= CYCLOTOMIC_ORDER_LIMIT) bound = CYCLOTOMIC_ORDER_LIMIT - 1;
+
+    int limit = (int)bound;
+    int *phi = (int*)malloc((limit + 1) * sizeof(int));
+
+    if(phi == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= limit; i++) phi[i] = i;
+
+    for(int i = 2; i <= limit; i++){
+
+        if(phi[i] != i) continue;
+
+        for(int j = i; j <= limit; j += i) phi[j] -= phi[j] / i;
+    }
+
+    *count = 0;
+
+    for(int d = 1; d <= limit; d++){
+
+        if(phi[d] <= n) phi[(*count)++] = d;
+    }
+
+    return phi;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long unityRoot(int d, unsigned long long* q){
+
+    unsigned long long primes[16];
+    int mult[16];
+    int numPrimes = factorInt(d, primes, mult);
+    unsigned long long k = CYCLOTOMIC_PRIME / (unsigned long long)d;
+
+    while(!isPrime(k * d + 1)) k++;
+
+    *q = k * d + 1;
+
+    for(unsigned long long g = 2; ; g++){
+
+        unsigned long long z = powMod(g, k, *q);
+        int primitive = (z != 1 || d == 1);
+
+        for(int i = 0; i < numPrimes && primitive; i++){
+
+            if(powMod(z, d / primes[i], *q) == 1) primitive = 0;
+        }
+
+        if(primitive) return z;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int cyclotomicOrders(polynomial p, const int* orders, int count, int* mult, long long* rest){
+
+    int n = 0;
+    long long *c = zpFromPoly(p, &n);
+    int total = 0;
+
+    for(int k = 0; k < count; k++) mult[k] = 0;
+
+    if(c == NULL) return -1;
+
+    long long *quot = (long long*)calloc(n + 1, sizeof(long long));
+
+    if(quot == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int k = 0; k < count && total < n; k++){
+
+        const long long *phi = NULL;
+        int deg = totient(orders[k]);
+        unsigned long long q = 0, z = 0;
+
+        while(n - total >= deg){
+
+            if(z == 0) z = unityRoot(orders[k], &q);
+
+            unsigned long long value = 0;
+
+            for(int i = n - total; i >= 0; i--){
+
+                long long r = c[i] % (long long)q;
+
+                value = mulMod(value, z, q) + (unsigned long long)((r < 0) ? r + (long long)q : r);
+
+                if(value >= q) value -= q;
+            }
+
+            if(value != 0) break;
+
+            if(phi == NULL) phi = cyclotomicCached(orders[k]);
+
+            if(phi == NULL || !zpDivExact(c, n - total, phi + 1, deg, quot)) break;
+
+            total += deg;
+
+            for(int i = 0; i <= n - total; i++) c[i] = quot[i];
+
+            mult[k]++;
+        }
+    }
+
+    if(rest != NULL){
+
+        for(int i = 0; i <= n - total; i++) rest[i] = c[i];
+    }
+
+    free(c);
+    free(quot);
+
+    return total;
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpFraction(const void* a, const void* b){
+
+    const int *x = (const int*)a;
+    const int *y = (const int*)b;
+    long long lhs = (long long)x[0] * y[1];
+    long long rhs = (long long)y[0] * x[1];
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+void printUnityRoots(const int* orders, const int* mult, int count, int m){
+
+    int size = 0;
+
+    for(int k = 0; k < count; k++){
+
+        if(mult[k] == m) size += totient(orders[k]);
+    }
+
+    int *roots = (int*)malloc((size + 1) * sizeof(int));
+    int numRoots = 0;
+
+    if(roots == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int k = 0; k < count; k++){
+
+        if(mult[k] != m) continue;
+
+        if(orders[k] == 1) printf("(%c - 1)", var);
+        if(orders[k] == 2) printf("(%c + 1)", var);
+
+        for(int j = 1; 2 * j < orders[k]; j++){
+
+            if(gcd(j, orders[k]) != 1) continue;
+
+            roots[2 * numRoots] = j;
+            roots[2 * numRoots + 1] = orders[k];
+            numRoots++;
+        }
+    }
+
+    qsort(roots, numRoots, 2 * sizeof(int), cmpFraction);
+
+    for(int i = 0; i < numRoots; i++){
+
+        int num = 2 * roots[2 * i];
+        int den = roots[2 * i + 1];
+        int divisor = gcd(num, den);
+
+        num /= divisor;
+        den /= divisor;
+
+        if (num == 1)
+            printf("(%c - Exp[i*Pi/%d])", var, den);
+        else
+            printf("(%c - Exp[%d*i*Pi/%d])", var, num, den);
+
+        if (num == 1)
+            printf("(%c - Exp[-i*Pi/%d])", var, den);
+        else
+            printf("(%c - Exp[-%d*i*Pi/%d])", var, num, den);
+    }
+
+    free(roots);
+}
+
+//-----------------------------------------------------------------------------
+
+int findN(polynomial p){
+
+    if(!isCyclotomicProduct(p)) return 0;
+
+    int n = p.terms[0].exponent;
+    int count = 0;
+    int *orders = cyclotomicCandidates(n, &count);
+    int *mult = (int*)malloc(count * sizeof(int));
+
+    if(mult == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    long long N = 0;
+
+    if(cyclotomicOrders(p, orders, count, mult, NULL) == n){
+
+        N = 1;
+
+        for(int k = 0; k < count && N > 0; k++){
+
+            if(mult[k] > 1) N = 0;
+            if(mult[k] != 1) continue;
+
+            N = N / gcd((int)(N % orders[k]), orders[k]) * orders[k];
+
+            if(N > INT_MAX) N = 0;
+        }
+    }
+
+    free(orders);
+    free(mult);
+
+    return (int)N;
+}
+
+//-----------------------------------------------------------------------------
+
+int dividesXPowerNMinusOne(polynomial p, int N){
+
+    int n = 0;
+    long long *f = zpFromPoly(p, &n);
+
+    if(f == NULL) return 0;
+
+    if(N < 1 || n < 0 || (f[n] != 1 && f[n] != -1)){
+
+        free(f);
+        return 0;
+    }
+
+    if(n == 0){
+
+        free(f);
+        return 1;
+    }
+
+    long long *r = (long long*)calloc(n, sizeof(long long));
+    long long *b = (long long*)calloc(n, sizeof(long long));
+    long long x[2] = {0, 1};
+    long long one[1] = {1};
+
+    if(r == NULL || b == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int dr = 0;
+    int db = zpMulMod(x, 1, one, 0, f, n, b);
+
+    r[0] = 1;
+
+    for(int e = N; e > 0 && dr >= 0 && db >= -1; e >>= 1){
+
+        if(e & 1) dr = zpMulMod(r, dr, b, db, f, n, r);
+        if(e > 1) db = zpMulMod(b, db, b, db, f, n, b);
+    }
+
+    int divides = (dr == 0 && r[0] == 1);
+
+    free(f);
+    free(r);
+    free(b);
+
+    return divides;
+}
+
+//-----------------------------------------------------------------------------
+
+void printCyclotomicRoots(int N, polynomial p){
+
+    int count = 0;
+    int *orders = divisors(N, &count);
+    int *mult = (int*)malloc(count * sizeof(int));
+
+    if(mult == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    cyclotomicOrders(p, orders, count, mult, NULL);
+    printUnityRoots(orders, mult, count, 1);
+
+    free(orders);
+    free(mult);
+}
+
+//-----------------------------------------------------------------------------
+
+char* intSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    long long numeratorSum = (-b + (long long)sqrtl(absDelta));
+    long long numeratorSub = (-b - (long long)sqrtl(absDelta));
+    unsigned char divisible = (numeratorSum % den == 0 && numeratorSub % den == 0) ? 1 : 0;
+
+    if(divisible){
+
+            snprintf(bSimplify, 256, "(%c%s %c %lld)(%c%s %c %lld)", var, powerRoot,
+            ((-b + sqrtl(absDelta))/den >= 0) ? '-' : '+', llabs((numeratorSum)/den), var, powerRoot,
+            ((-b - sqrtl(absDelta))/den >= 0) ? '-' : '+', llabs((numeratorSub)/den));
+        }
+
+        else if(!divisible && b != 0){
+
+            snprintf(bSimplify, 256, "(%c%s - (%lld + %lld)/%lld)(%c%s - (%lld - %lld)/%lld)", var, powerRoot,
+             -b, (long long)sqrtl(absDelta), den, var, powerRoot,
+             -b, (long long)sqrtl(absDelta), den);
+        }
+
+        else{
+
+            snprintf(bSimplify, 256, "(%c%s %c (%lld/%lld))(%c%s %c (%lld/%lld))", var, powerRoot,
+            (-b + sqrtl(absDelta) >= 0) ? '-' : '+', (long long)sqrtl(absDelta), den, var, powerRoot,
+            (-b + sqrtl(absDelta) >= 0) ? '+' : '-', (long long)sqrtl(absDelta), den);
+        }
+
+
+    return bSimplify;
+}
+
+//-----------------------------------------------------------------------------
+
+char* intSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    if(-b % den == 0 && (long long)sqrtl(absDelta) % den == 0 && (long long)sqrtl(absDelta) / den != 1 && b != 0){
+        snprintf(bSimplify, 256, "(%c%s - (%lld + %lldi))(%c%s - (%lld - %lldi))", var, powerRoot,
+                -b/den, (long long)sqrtl(absDelta)/den, var, powerRoot, -b/den, (long long)sqrtl(absDelta)/den);
+    }
+    else if(-b % den == 0 && (long long)sqrtl(absDelta) % den == 0 && b != 0){
+        snprintf(bSimplify, 256, "(%c%s - (%lld + i))(%c%s - (%lld - i))", var, powerRoot,
+                -b/den, var, powerRoot, -b/den);
+    }
+    else if((-b % den != 0 || (long long)sqrtl(absDelta) % den != 0) && b != 0){
+        snprintf(bSimplify, 256, "(%c%s - (%lld + %lldi)/%lld)(%c%s - (%lld - %lldi)/%lld)", var, powerRoot,
+                -b, (long long)sqrtl(absDelta), den, var, powerRoot, -b, (long long)sqrtl(absDelta), den);
+    }
+    else if((long long)sqrtl(absDelta) % den == 0 && (long long)sqrtl(absDelta) / den != 1 && b == 0){
+        snprintf(bSimplify, 256, "(%c%s - %lldi)(%c%s + %lldi)", var, powerRoot,
+                (long long)sqrtl(absDelta)/den, var, powerRoot, (long long)sqrtl(absDelta)/den);
+    }
+    else if((long long)sqrtl(absDelta) % den == 0 && b == 0){
+        snprintf(bSimplify, 256, "(%c%s - i)(%c%s + i)", var, powerRoot, var, powerRoot);
+    }
+    else{
+        snprintf(bSimplify, 256, "(%c%s - %lldi/%lld)(%c%s + %lldi/%lld)", var, powerRoot,
+                (long long)sqrtl(absDelta), den, var, powerRoot, (long long)sqrtl(absDelta), den);
+    }
+
+    return bSimplify;
+}
+
+//-----------------------------------------------------------------------------
+
+long long surdReduce(long long* b, long long* den, long long* radicand){
+
+    unsigned long long primes[16];
+    int mult[16];
+    int numPrimes = factorInt(*radicand, primes, mult);
+    long long s = 1;
+
+    // radicand = s^2 r with r square-free
+    for(int i = 0; i < numPrimes; i++){
+
+        for(int e = 1; e < mult[i]; e += 2){
+
+            s *= (long long)primes[i];
+            *radicand /= (long long)(primes[i] * primes[i]);
+        }
+    }
+
+    long long g = (long long)ullGcd(ullGcd(llabs(*b), s), llabs(*den));
+
+    *b /= g;
+    *den /= g;
+
+    return s / g;
+}
+
+//-----------------------------------------------------------------------------
+
+char* floatSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    char surd[48];
+    long long s = surdReduce(&b, &den, &absDelta);
+
+    if(s == 1) snprintf(surd, sizeof(surd), "Sqrt[%lld]", absDelta);
+    else snprintf(surd, sizeof(surd), "%lldSqrt[%lld]", s, absDelta);
+
+    if(b != 0 && den == 1){
+        snprintf(bSimplify, 256, "(%c%s - (%lld + %s))(%c%s - (%lld - %s))", var, powerRoot,
+                -b, surd, var, powerRoot, -b, surd);
+    }
+    else if(b != 0){
+        snprintf(bSimplify, 256, "(%c%s - ((%lld + %s)/%lld))(%c%s - ((%lld - %s)/%lld))", var, powerRoot,
+                -b, surd, den, var, powerRoot,
+                -b, surd, den);
+    }
+    else if(den == 1){
+        snprintf(bSimplify, 256, "(%c%s - %s)(%c%s + %s)", var, powerRoot, surd, var, powerRoot, surd);
+    }
+    else{
+        snprintf(bSimplify, 256, "(%c%s - (%s/%lld))(%c%s + (%s/%lld))", var, powerRoot,
+               surd, den, var, powerRoot, surd, den);
+    }
+
+    return bSimplify;
+}
+
+//-----------------------------------------------------------------------------
+
+char* floatSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    char surd[48];
+    long long s = surdReduce(&b, &den, &absDelta);
+
+    if(s == 1) snprintf(surd, sizeof(surd), "iSqrt[%lld]", absDelta);
+    else snprintf(surd, sizeof(surd), "%lldiSqrt[%lld]", s, absDelta);
+
+    if(b != 0 && den == 1){
+        snprintf(bSimplify, 256, "(%c%s - (%lld + %s))(%c%s - (%lld - %s))", var, powerRoot,
+                -b, surd, var, powerRoot, -b, surd);
+    }
+    else if(b != 0){
+        snprintf(bSimplify, 256, "(%c%s - ((%lld + %s)/%lld))(%c%s - ((%lld - %s)/%lld))", var, powerRoot,
+                -b, surd, den, var, powerRoot,
+                -b, surd, den);
+    }
+    else if(den == 1){
+        snprintf(bSimplify, 256, "(%c%s - %s)(%c%s + %s)", var, powerRoot, surd, var, powerRoot, surd);
+    }
+    else{
+        snprintf(bSimplify, 256, "(%c%s - (%s/%lld))(%c%s + (%s/%lld))", var, powerRoot,
+               surd, den, var, powerRoot, surd, den);
+    }
+
+    return bSimplify;
+}
+
+//-----------------------------------------------------------------------------
+
+char* rationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    if(delta >= 0)
+        return intSrPositiveDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+
+    return intSrNegativeDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+}
+
+//-----------------------------------------------------------------------------
+
+char* irrationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot){
+
+    if(delta >= 0){
+
+        return floatSrPositiveDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+    }
+
+    return floatSrNegativeDelta(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+}
+
+//-----------------------------------------------------------------------------
+
+char* bhaskaraSimplify(int aexp, long long den, long long b, double delta, long long absDelta, double* rootsPair){
+
+    char* bSimplify = malloc(sizeof(char) * 256);
+    char powerRoot[16] = "";
+    long long root = (long long)sqrtl(absDelta);
+    unsigned char perfectSquare = (root * root == absDelta) ? 1 : 0;
+
+    if(aexp > 2){
+
+        snprintf(powerRoot, sizeof(powerRoot), "^%d", aexp / 2);
+    }
+
+    if(perfectSquare){
+
+        return rationalSqRoots(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+    }
+    else{
+
+        return irrationalSqRoots(aexp, den, b, delta, absDelta, bSimplify, powerRoot);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void bhaskara(polynomial p) {
+
+    if (pHasBig(p)) {
+
+        aberth(p);
+        return;
+    }
+
+    int aexp = p.terms[0].exponent;
+
+    long long a = 0, b = 0, c = 0;
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        int expo = p.terms[i].exponent;
+        int coef = p.terms[i].coefficient;
+
+        if (i == 0)      a = coef;
+        else if (i == 1) b = coef;
+        else if (i == 2) c = coef;
+    }
+
+    long long den = 2 * a;
+
+    // b^2 - 4ac reaches 2^64 for int coefficients
+    __int128 exactDelta = (__int128)b * b - (__int128)4 * a * c;
+
+    if (exactDelta > LLONG_MAX || exactDelta < -LLONG_MAX) {
+
+        aberth(p);
+        return;
+    }
+
+    double delta = (double)exactDelta;
+    double rootsPair[2] = {0, 0};
+
+    long long absDelta = llabs((long long)exactDelta);
+
+    rootsPair[0] = (-b + sqrt(absDelta)) / den;
+    rootsPair[1] = (-b - sqrt(absDelta)) / den;
+
+    char* bSimplify = bhaskaraSimplify(aexp, den, b, delta, absDelta, rootsPair);
+
+    printf("%s", bSimplify);
+
+    free(bSimplify);
+}
+
+//-----------------------------------------------------------------------------
+
+void briotRuffini(polynomial p, int maxNum){
+
+    if(pHasBig(p)){
+
+        bigBriotRuffini(p);
+        return;
+    }
+
+    int aexp = p.terms[0].exponent;
+    int numTermsATM = p.numTerms;
+    int r = 0, numCand = 0, numLead = 0, numConst = 0;
+
+    int *leadDiv = divisors(p.terms[0].coefficient, &numLead);
+    int *constDiv = divisors(p.terms[p.numTerms - 1].coefficient, &numConst);
+
+    int *candNum = (int*)malloc(2 * numLead * numConst * sizeof(int));
+    int *candDen = (int*)malloc(2 * numLead * numConst * sizeof(int));
+    int *rootNum = (int*)calloc(aexp, sizeof(int));
+    int *rootDen = (int*)calloc(aexp, sizeof(int));
+    long long *aux = (long long*)malloc(p.numTerms * sizeof(long long));
+
+    if(candNum == NULL || candDen == NULL || rootNum == NULL || rootDen == NULL || aux == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int s = 1; s >= -1; s -= 2){
+
+        for(int j = 0; j < numLead; j++){
+
+            for(int k = 0; k < numConst; k++){
+
+                if(gcd(leadDiv[j], constDiv[k]) != 1) continue;
+
+                int pos = numCand;
+
+                while(pos > 0 && (candNum[pos-1] > 0) == (s > 0) &&
+                      (long long)candNum[pos-1] * leadDiv[j] > (long long)s * constDiv[k] * candDen[pos-1]){
+
+                    candNum[pos] = candNum[pos-1];
+                    candDen[pos] = candDen[pos-1];
+                    pos--;
+                }
+
+                candNum[pos] = s * constDiv[k];
+                candDen[pos] = leadDiv[j];
+                numCand++;
+            }
+        }
+    }
+
+    for(int c = 0; c < numCand && r < aexp; c++){
+
+        long long num = candNum[c], den = candDen[c];
+        int isRoot = 1;
+
+        while(isRoot && numTermsATM > 1){
+
+            if(p.terms[0].coefficient % den != 0) break;
+
+            aux[0] = p.terms[0].coefficient / den;
+
+            for(int k = 1; k < numTermsATM - 1 && isRoot; k++){
+
+                long long step = p.terms[k].coefficient + num * aux[k-1];
+
+                if(step % den != 0 || step / den > INT_MAX || step / den < -INT_MAX) isRoot = 0;
+                else aux[k] = step / den;
+            }
+
+            if(!isRoot || p.terms[numTermsATM-1].coefficient + num * aux[numTermsATM-2] != 0) break;
+
+            rootNum[r] = (int)num;
+            rootDen[r] = (int)den;
+            r++;
+            numTermsATM--;
+
+            for(int j = 0; j < numTermsATM; j++){
+
+                p.terms[j] = setTerms((int)aux[j], numTermsATM - 1 - j);
+            }
+        }
+    }
+
+    for(int l = 0; l < r; l++){
+
+        if(rootDen[l] == 1) printf("(%c %c %i)", var, (rootNum[l] > 0) ? '-' : '+', abs(rootNum[l]));
+        else printf("(%i%c %c %i)", rootDen[l], var, (rootNum[l] > 0) ? '-' : '+', abs(rootNum[l]));
+    }
+
+    polynomial rest = p;
+    rest.numTerms = numTermsATM;
+
+    if(numTermsATM == 1){
+
+        if(rest.terms[0].coefficient != 1) printf("(%i)", rest.terms[0].coefficient);
+    }
+    else{
+
+        int numFactors = 0;
+        polynomial *factors = zassenhaus(rest, &numFactors);
+
+        // too large to factor exactly, so its roots are approximated
+        if(factors == NULL) aberth(rest);
+
+        for(int i = 0; i < numFactors; i++){
+
+            irreducibleFac(factors[i]);
+            termsFree(factors[i].terms, factors[i].numTerms);
+        }
+
+        free(factors);
+    }
+
+    sol = 1;
+
+    free(leadDiv);
+    free(constDiv);
+    free(candNum);
+    free(candDen);
+    free(rootNum);
+    free(rootDen);
+    free(aux);
+}
+
+//-----------------------------------------------------------------------------
+
+long long* bigDivisors(const bigInt* x, int* count){
+
+    unsigned long long primes[16];
+    int mult[16];
+
+    *count = 0;
+
+    // factorInt() needs a long long
+    if(x->size == 0 || x->size > 1 || x->limb[0] > LLONG_MAX) return NULL;
+
+    int numPrimes = factorInt((long long)x->limb[0], primes, mult);
+    int total = 1;
+
+    for(int i = 0; i < numPrimes; i++) total *= mult[i] + 1;
+
+    long long *list = (long long*)malloc(total * sizeof(long long));
+
+    if(list == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    list[(*count)++] = 1;
+
+    for(int i = 0; i < numPrimes; i++){
+
+        int prev = *count;
+        long long power = 1;
+
+        for(int e = 1; e <= mult[i]; e++){
+
+            power *= (long long)primes[i];
+
+            for(int j = 0; j < prev; j++) list[(*count)++] = list[j] * power;
+        }
+    }
+
+    qsort(list, *count, sizeof(long long), cmpUll);
+
+    return list;
+}
+
+//-----------------------------------------------------------------------------
+
+void bigBriotRuffini(polynomial p){
+
+    int deg = 0, numLead = 0, numConst = 0;
+    bigInt *c = bigsFromPoly(p, &deg);
+    long long *leadDiv = bigDivisors(&c[deg], &numLead);
+    long long *constDiv = bigDivisors(&c[0], &numConst);
+
+    // candidates u/v come from the ends that fit in a long long, and each is
+    // tested exactly as the sign of v^n p(u/v)
+    if((long long)numLead * numConst > BIG_ROOT_CANDIDATES) numLead = 0;
+
+    for(int s = 1; s >= -1; s -= 2){
+
+        for(int j = 0; j < numLead; j++){
+
+            for(int k = 0; k < numConst; k++){
+
+                long long u = s * constDiv[k], v = leadDiv[j];
+
+                if(ullGcd(constDiv[k], v) != 1) continue;
+
+                while(deg > 0 && bigPolySign(c, deg, u, v) == 0){
+
+                    if(v == 1) printf("(%c %c %lld)", var, (u > 0) ? '-' : '+', llabs(u));
+                    else printf("(%lld%c %c %lld)", v, var, (u > 0) ? '-' : '+', llabs(u));
+
+                    // p = (vx - u) q, so q[i-1] = (p[i] + u q[i]) / v from the top
+                    bigInt *q = bigsCreate(deg);
+
+                    for(int i = deg; i >= 1; i--){
+
+                        bigAdd(&q[i-1], &c[i]);
+
+                        if(i < deg) bigAddMul(&q[i-1], &q[i], u);
+
+                        bigDivSmall(&q[i-1], v);
+                    }
+
+                    bigsFree(c, deg + 1);
+                    c = q;
+                    deg--;
+                }
+            }
+        }
+    }
+
+    if(deg == 1){
+
+        // ax + b in lowest terms, with the content printed apart as in briotRuffini()
+        bigInt g, rem;
+
+        bigInit(&g, 0);
+        bigInit(&rem, 0);
+        bigGcd(&c[1], &c[0], &g);
+
+        g.sign = c[1].sign;
+
+        bigDivMod(&c[1], &g, &c[1], &rem);
+        bigDivMod(&c[0], &g, &c[0], &rem);
+
+        printf("(");
+
+        if(c[1].size != 1 || c[1].limb[0] != 1) bigPrint(&c[1]);
+
+        printf("%c %c ", var, (c[0].sign < 0) ? '-' : '+');
+
+        if(c[0].sign < 0) c[0].sign = 1;
+
+        bigPrint(&c[0]);
+        printf(")");
+
+        if(g.size != 1 || g.limb[0] != 1 || g.sign < 0){
+
+            printf("(");
+            bigPrint(&g);
+            printf(")");
+        }
+
+        bigFree(&g);
+        bigFree(&rem);
+        bigsFree(c, 2);
+    }
+    else if(deg > 1){
+
+        polynomial rest = bigsToPoly(c, deg);
+
+        // deflation can bring every coefficient back into int range
+        if(pHasBig(rest)) aberth(rest);
+        else briotRuffini(rest, 0);
+
+        termsFree(rest.terms, rest.numTerms);
+    }
+    else{
+
+        if(c[0].size != 1 || c[0].limb[0] != 1 || c[0].sign < 0){
+
+            printf("(");
+            bigPrint(&c[0]);
+            printf(")");
+        }
+
+        bigsFree(c, 1);
+    }
+
+    sol = 1;
+
+    free(leadDiv);
+    free(constDiv);
+}
+
+//-----------------------------------------------------------------------------
+
+void irreducibleFac(polynomial p){
+
+    if(pHasBig(p)){
+
+        aberth(p);
+        return;
+    }
+
+    int deg = p.terms[0].exponent;
+    int N = (deg > 2) ? findN(p) : 0;
+    int trinomial = (deg > 2 && deg % 2 == 0 && p.numTerms == deg + 1);
+    int nonZero = 0;
+
+    for(int i = 0; i < p.numTerms; i++) nonZero += (p.terms[i].coefficient != 0);
+
+    for(int i = 1; i < deg && trinomial; i++){
+
+        if(i != deg / 2 && p.terms[i].coefficient != 0) trinomial = 0;
+    }
+
+    if(deg == 1){
+
+        if(p.terms[0].coefficient == 1) printf("(%c %c %i)", var, (p.terms[1].coefficient < 0) ? '-' : '+', abs(p.terms[1].coefficient));
+        else printf("(%i%c %c %i)", p.terms[0].coefficient, var, (p.terms[1].coefficient < 0) ? '-' : '+', abs(p.terms[1].coefficient));
+    }
+    else if(nonZero == 2 && p.terms[p.numTerms - 1].exponent == 0 && p.terms[p.numTerms - 1].coefficient != 0){
+
+        // same closed form fac() prints when the binomial is the whole input
+        binomialFac(p);
+    }
+    else if(deg == 2){
+
+        bhaskara(p);
+    }
+    else if(N > 0){
+
+        printCyclotomicRoots(N, p);
+    }
+    else if(trinomial){
+
+        polynomial quad = pCreate(3);
+
+        quad.terms[0] = setTerms(p.terms[0].coefficient, deg);
+        quad.terms[1] = setTerms(p.terms[deg / 2].coefficient, deg / 2);
+        quad.terms[2] = setTerms(p.terms[deg].coefficient, 0);
+
+        bhaskara(quad);
+        free(quad.terms);
+    }
+    else if(deg == 3){
+
+        cardano(p);
+    }
+    else if(deg == 4){
+
+        ferrari(p);
+    }
+    else{
+
+        aberth(p);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void removeZeros(polynomial *p) {
+
+    if (p == NULL || p->terms == NULL || p->numTerms == 0) return;
+
+    int indexWrite = 0;
+
+    for (int indexRead = 0; indexRead < p->numTerms; indexRead++) {
+        if (p->terms[indexRead].coefficient != 0) {
+            if (indexWrite != indexRead) {
+
+                p->terms[indexWrite] = p->terms[indexRead];
+            }
+
+            indexWrite++;
+        }
+    }
+
+    if (indexWrite == p->numTerms) return;
+
+    if (indexWrite == 0) {
+
+        free(p->terms);
+        p->terms = NULL;
+        p->numTerms = 0;
+        return;
+    }
+
+    term *temp = (term*)realloc(p->terms, indexWrite * sizeof(term));
+
+    if (temp != NULL) {
+
+        p->terms = temp;
+        p->numTerms = indexWrite;
+    } else {
+
+        p->numTerms = indexWrite;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void fac(polynomial p) {
+
+    int maxExp = 0;
+    int binary = 1;
+    int littlewood = 1;
+    int nonZero = 0;
+    int constant = 0;
+    int big = 0;
+
+    sol = 0;
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        binary *= p.terms[i].exponent;
+    }
+
+    if (binary != 0){
+
+        divideX(p);
+        return;
+    }
+
+    divideGCD(p);
+
+    for (int j = 0; j < p.numTerms; j++) {
+
+        if (p.terms[j].coefficient > 1 || p.terms[j].coefficient < -1) littlewood = 0;
+        if (p.terms[j].coefficient != 0) nonZero++;
+        if (p.terms[j].coefficient != 0 && p.terms[j].exponent == 0) constant = 1;
+        if (p.terms[j].big != NULL) big = 1;
+
+		maxExp = (p.terms[j].exponent > maxExp) ? p.terms[j].exponent : maxExp;
+    }
+
+    if(divider > 1 || divider < -1) printf("%lld", divider);
+    else if(divider == -1) printf("-");
+
+    if(degreeX != 0){
+
+        printf("%c^%d", var, degreeX);
+
+        if(maxExp == 0){
+
+            printf("\n\n");
+            return;
+        }
+    }
+
+    if(big){
+
+        // the closed forms below read int coefficients, so heap input goes
+        // straight to the square-free split and the exact rational roots of
+        // briotRuffini(); the gcd behind the split costs no more than a
+        // discriminant that would only say whether the split is needed
+        squareFreeFac(p, 0);
+        sol = 1;
+    }
+    else if(nonZero == 2 && constant){
+
+        binomialFac(p);
+        sol = 1;
+    }
+    else if((littlewood && maxExp > 0) || isCyclotomicProduct(p)){
+
+        cyclotomicFac(p);
+        sol = 1;
+    }
+    else{
+
+        squareFreeFac(p, 0);
+    }
+
+    degreeX = 0;
     printf("\n\n");
 
-    return;
+    return;
+}
+
+//-----------------------------------------------------------------------------
+
+void squareFreeFac(polynomial p, int numeric){
+
+    int numParts = 0;
+    polynomial *parts = squareFree(p, &numParts);
+
+    for(int i = 0; i < numParts; i++){
+
+        int partDeg = parts[i].terms[0].exponent;
+
+        if(partDeg > 0){
+
+            int N = numeric ? 0 : findN(parts[i]);
+
+            if(i > 0 && partDeg > 1) printf("(");
+
+            if(numeric) irreducibleFac(parts[i]);
+            else if(N > 0) printCyclotomicRoots(N, parts[i]);
+            else briotRuffini(parts[i], 0);
+
+            if(i > 0 && partDeg > 1) printf(")");
+            if(i > 0) printf("^%d", i + 1);
+        }
+
+        termsFree(parts[i].terms, parts[i].numTerms);
+    }
+
+    free(parts);
+}
+
+//-----------------------------------------------------------------------------
+
+void divideX(polynomial p) {
+
+    int minExp = p.terms[0].exponent;
+
+    for (int i = 1; i < p.numTerms; i++) {
+
+        if (p.terms[i].exponent < minExp) minExp = p.terms[i].exponent;
+    }
+
+    polynomial remainder = pCreate(p.numTerms);
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        remainder.terms[i] = setTerms(0, p.terms[i].exponent - minExp);
+        termAdd(&remainder.terms[i], p.terms[i]);
+    }
+
+    removeZeros(&remainder);
+
+    degreeX = minExp;
+
+    fac(remainder);
+
+    termsFree(remainder.terms, remainder.numTerms);
+}
+
+//-----------------------------------------------------------------------------
+
+void divideGCD(polynomial p){
+
+    unsigned long long g = 0;
+
+    // the gcd is seeded by the coefficients below 2^64, then reduced by the rest
+    for (int i = 0; i < p.numTerms; i++){
+
+        if (p.terms[i].big == NULL) g = ullGcd(g, (unsigned long long)llabs(p.terms[i].coefficient));
+        else if (p.terms[i].big->size == 1) g = ullGcd(g, p.terms[i].big->limb[0]);
+    }
+
+    for (int i = 0; i < p.numTerms && g > 1; i++){
+
+        if (p.terms[i].big != NULL) g = ullGcd(g, bigModSmall(p.terms[i].big, g));
+    }
+
+    if (g == 0 || g > LLONG_MAX) g = 1;
+
+    divider = (p.terms[0].coefficient < 0) ? -(long long)g : (long long)g;
+
+    for (int j = 0; j < p.numTerms; j++){
+
+        if (p.terms[j].big != NULL){
+
+            bigInt x = *p.terms[j].big;
+
+            bigDivSmall(&x, divider);
+            free(p.terms[j].big);
+            p.terms[j] = termFromBig(&x, p.terms[j].exponent);
+        }
+        else p.terms[j].coefficient /= divider;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial* squareFree(polynomial p, int* numParts){
+
+    int deg = 0, dd = 0, da = 0, db = 0, dc = 0, dt = 0;
+    long long *f = zpFromPoly(p, &deg);
+
+    if(f == NULL) return bigSquareFree(p, numParts);
+
+    zpPrimitive(f, deg);
+
+    polynomial *parts = (polynomial*)malloc((deg + 2) * sizeof(polynomial));
+    long long *a = (long long*)calloc(deg + 1, sizeof(long long));
+    long long *b = (long long*)calloc(deg + 1, sizeof(long long));
+    long long *c = (long long*)calloc(deg + 1, sizeof(long long));
+    long long *d = (long long*)calloc(deg + 1, sizeof(long long));
+    long long *t = (long long*)calloc(deg + 1, sizeof(long long));
+
+    if(parts == NULL || a == NULL || b == NULL || c == NULL || d == NULL || t == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    *numParts = 0;
+
+    dd = zpDerivative(f, deg, d);
+    da = (deg > 0) ? zpGcd(f, deg, d, dd, a) : -2;
+
+    if(da >= 0){
+
+        db = deg - da;
+        dc = dd - da;
+        zpDivExact(f, deg, a, da, b);
+        zpDivExact(d, dd, a, da, c);
+
+        while(db > 0 && da >= 0){
+
+            dt = zpDerivative(b, db, t);
+
+            for(int i = 0; i <= ((dc > dt) ? dc : dt); i++){
+
+                d[i] = ((i <= dc) ? c[i] : 0) - ((i <= dt) ? t[i] : 0);
+            }
+
+            dd = zpTrim(d, (dc > dt) ? dc : dt);
+            da = zpGcd(b, db, d, dd, a);
+
+            if(da < 0) break;
+
+            parts[(*numParts)++] = zpToPoly(a, da);
+
+            zpDivExact(b, db, a, da, t);
+            db -= da;
+
+            for(int i = 0; i <= db; i++) b[i] = t[i];
+
+            zpDivExact(d, dd, a, da, c);
+            dc = dd - da;
+        }
+    }
+
+    if(da < 0 && deg <= 0){
+
+        parts[0] = zpToPoly(f, deg);
+        *numParts = 1;
+    }
+
+    free(f);
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(t);
+
+    // an intermediate coefficient overflowed: Yun's algorithm is run again
+    // with multi-limb coefficients
+    if(da < 0 && deg > 0){
+
+        for(int i = 0; i < *numParts; i++) termsFree(parts[i].terms, parts[i].numTerms);
+
+        free(parts);
+
+        return bigSquareFree(p, numParts);
+    }
+
+    return parts;
+}
+
+//-----------------------------------------------------------------------------
+
+int zpFromLifted(unsigned long long** factors, const int* degs, const int* idx, int count, long long lc, unsigned long long M, unsigned long long* aux, long long* g){
+
+    int dg = 0;
+
+    aux[0] = (unsigned long long)(lc % (long long)M + (long long)M) % M;
+
+    for(int i = 0; i < count; i++){
+
+        unsigned long long *factor = factors[idx[i]];
+        int df = degs[idx[i]];
+
+        for(int j = dg + df; j >= 0; j--){
+
+            unsigned long long sum = 0;
+
+            for(int k = 0; k <= df && k <= j; k++){
+
+                if(j - k <= dg) sum = (sum + mulMod(factor[k], aux[j - k], M)) % M;
+            }
+
+            aux[j] = sum;
+        }
+
+        dg += df;
+    }
+
+    for(int i = 0; i <= dg; i++) g[i] = (aux[i] > M / 2) ? -(long long)(M - aux[i]) : (long long)aux[i];
+
+    zpPrimitive(g, dg);
+
+    return dg;
+}
+
+//-----------------------------------------------------------------------------
+
+void lllReduce(long double** b, int rows, int cols, long double* norms){
+
+    long double *mu = (long double*)calloc(rows * rows, sizeof(long double));
+    long double *star = (long double*)calloc(rows * cols, sizeof(long double));
+
+    if(mu == NULL || star == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int k = 1, valid = 0; valid < rows; ){
+
+        for(; valid <= k && valid < rows; valid++){
+
+            int i = valid;
+
+            for(int c = 0; c < cols; c++) star[i * cols + c] = b[i][c];
+
+            for(int j = 0; j < i; j++){
+
+                long double dot = 0;
+
+                for(int c = 0; c < cols; c++) dot += b[i][c] * star[j * cols + c];
+
+                mu[i * rows + j] = (norms[j] > 0) ? dot / norms[j] : 0;
+
+                for(int c = 0; c < cols; c++) star[i * cols + c] -= mu[i * rows + j] * star[j * cols + c];
+            }
+
+            norms[i] = 0;
+
+            for(int c = 0; c < cols; c++) norms[i] += star[i * cols + c] * star[i * cols + c];
+        }
+
+        if(k >= rows) break;
+
+        int reduced = 0;
+
+        for(int j = k - 1; j >= 0; j--){
+
+            if(fabsl(mu[k * rows + j]) <= LLL_ETA) continue;
+
+            long double q = roundl(mu[k * rows + j]);
+
+            for(int c = 0; c < cols; c++) b[k][c] -= q * b[j][c];
+            for(int l = 0; l < j; l++) mu[k * rows + l] -= q * mu[j * rows + l];
+
+            mu[k * rows + j] -= q;
+            reduced = 1;
+        }
+
+        if(reduced){
+
+            valid = k;
+            continue;
+        }
+
+        if(norms[k] >= (LLL_DELTA - mu[k * rows + k - 1] * mu[k * rows + k - 1]) * norms[k-1]){
+
+            k++;
+            continue;
+        }
+
+        long double *row = b[k];
+
+        b[k] = b[k-1];
+        b[k-1] = row;
+        valid = k - 1;
+
+        if(k > 1) k--;
+    }
+
+    free(mu);
+    free(star);
+}
+
+//-----------------------------------------------------------------------------
+
+int vanHoeij(const long long* f, int n, unsigned long long** factors, const int* degs, const int* live, int r, unsigned long long M, int* group){
+
+    long long lc = f[n];
+    double lo = 0, hi = 0;
+
+    for(int i = 0; i < n; i++){
+
+        double root = 2 * pow(fabs((double)f[i]) / fabs((double)lc), 1.0 / (n - i));
+
+        hi = (root > hi) ? root : hi;
+    }
+
+    for(int iter = 0; iter < 100; iter++){
+
+        double mid = (lo + hi) / 2, sum = 0;
+
+        for(int i = 0; i < n; i++) sum += fabs((double)f[i]) * pow(mid, i - n);
+
+        if(sum > fabs((double)lc)) lo = mid;
+        else hi = mid;
+    }
+
+    double rootBits = log2(fabs((double)lc) * hi * (1 + 1e-9));
+    double modBits = log2((double)M);
+    int s = 0;
+
+    while(s < n && modBits - (log2((double)n) + (s + 1) * rootBits + 1) >= VANHOEIJ_MARGIN) s++;
+
+    if(s == 0) return 0;
+
+    unsigned long long lcM = (unsigned long long)(lc % (long long)M + (long long)M) % M;
+    unsigned long long *sums = (unsigned long long*)calloc(s + 1, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * n + 2, sizeof(unsigned long long));
+    unsigned long long **traces = (unsigned long long**)malloc(r * sizeof(unsigned long long*));
+    long long **W = (long long**)malloc((r + 1) * sizeof(long long*));
+    long double **b = (long double**)malloc((r + 1) * sizeof(long double*));
+    long double *norms = (long double*)calloc(r + 1, sizeof(long double));
+    long long *g = (long long*)calloc(n + 1, sizeof(long long));
+    long long *quot = (long long*)calloc(n + 1, sizeof(long long));
+    int *pick = (int*)malloc(r * sizeof(int));
+
+    if(sums == NULL || aux == NULL || traces == NULL || W == NULL || b == NULL || norms == NULL || g == NULL || quot == NULL || pick == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    for(int i = 0; i <= r; i++){
+
+        W[i] = (long long*)calloc(r, sizeof(long long));
+        b[i] = (long double*)calloc(r + 1, sizeof(long double));
+
+        if(W[i] == NULL || b[i] == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+    }
+
+    for(int i = 0; i < r; i++){
+
+        unsigned long long *h = factors[live[i]];
+        int d = degs[live[i]];
+        unsigned long long lcPow = 1;
+
+        traces[i] = (unsigned long long*)calloc(s + 1, sizeof(unsigned long long));
+
+        if(traces[i] == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for(int j = 1; j <= s; j++){
+
+            unsigned long long sum = (j <= d) ? mulMod(j % M, h[d - j], M) : 0;
+
+            for(int k = 1; k < j && k <= d; k++) sum = (sum + mulMod(h[d - k], sums[j - k], M)) % M;
+
+            sums[j] = (M - sum) % M;
+            lcPow = mulMod(lcPow, lcM, M);
+            traces[i][j] = mulMod(sums[j], lcPow, M);
+        }
+
+        W[i][i] = 1;
+    }
+
+    int m = r, groups = 0;
+
+    for(int j = 1; j <= s && groups == 0; j++){
+
+        double cut = ceil(log2((double)n) + j * rootBits);
+
+        if(modBits - cut > VANHOEIJ_COLUMN_BITS) cut = modBits - VANHOEIJ_COLUMN_BITS;
+
+        long double scale = ldexpl(1.0L, -(int)cut);
+
+        for(int k = 0; k < m; k++){
+
+            __int128 acc = 0;
+
+            for(int i = 0; i < r; i++){
+
+                b[k][i] = (long double)W[k][i];
+                acc += (__int128)W[k][i] * (long long)((traces[i][j] > M / 2) ? -(long long)(M - traces[i][j]) : (long long)traces[i][j]);
+            }
+
+            acc %= (__int128)M;
+
+            if(acc > (__int128)(M / 2)) acc -= M;
+            if(acc < -(__int128)(M / 2)) acc += M;
+
+            b[k][r] = (long double)(long long)acc * scale;
+        }
+
+        for(int i = 0; i < r; i++) b[m][i] = 0;
+
+        b[m][r] = (long double)M * scale;
+
+        lllReduce(b, m + 1, r + 1, norms);
+
+        int kept = m + 1;
+
+        while(kept > 0 && norms[kept-1] > (long double)(r + 1)) kept--;
+
+        if(kept == 0) break;
+        if(kept > m) continue;
+
+        for(int k = 0; k < kept; k++){
+
+            for(int i = 0; i < r; i++) W[k][i] = (long long)roundl(b[k][i]);
+        }
+
+        m = kept;
+
+        for(int i = 0; i < r; i++){
+
+            int zero = 1;
+
+            group[i] = -1;
+
+            for(int k = 0; k < m && zero; k++) zero = (W[k][i] == 0);
+
+            for(int t = 0; t < i && group[i] < 0 && !zero; t++){
+
+                int same = 1;
+
+                for(int k = 0; k < m && same; k++) same = (W[k][i] == W[k][t]);
+
+                if(same) group[i] = group[t];
+            }
+
+            if(group[i] < 0 && !zero) group[i] = groups++;
+        }
+
+        int valid = (groups == m);
+
+        for(int i = 0; i < r && valid; i++) valid = (group[i] >= 0);
+
+        for(int k = 0; k < groups && valid; k++){
+
+            int count = 0;
+
+            for(int i = 0; i < r; i++) if(group[i] == k) pick[count++] = live[i];
+
+            int dg = zpFromLifted(factors, degs, pick, count, lc, M, aux, g);
+
+            valid = (dg > 0 && zpDivExact(f, n, g, dg, quot));
+        }
+
+        if(!valid) groups = 0;
+    }
+
+    for(int i = 0; i < r; i++) free(traces[i]);
+
+    for(int i = 0; i <= r; i++){
+
+        free(W[i]);
+        free(b[i]);
+    }
+
+    free(sums);
+    free(aux);
+    free(traces);
+    free(W);
+    free(b);
+    free(norms);
+    free(g);
+    free(quot);
+    free(pick);
+
+    return groups;
+}
+
+//-----------------------------------------------------------------------------
+
+polynomial* zassenhaus(polynomial p, int* numFactors){
+
+    int n = 0;
+    long long *f = zpFromPoly(p, &n);
+
+    // heap coefficients put the Landau-Mignotte bound past 62 bits, and past
+    // ZASSENHAUS_MAX_DEGREE the distinct-degree factorization mod each prime,
+    // cubic in the degree, dominates everything else; neither is handled
+    if(f == NULL || n > ZASSENHAUS_MAX_DEGREE){
+
+        free(f);
+        *numFactors = -1;
+
+        return NULL;
+    }
+
+    zpPrimitive(f, n);
+
+    polynomial *result = (polynomial*)malloc((n + 1) * sizeof(polynomial));
+    unsigned long long **facs = (unsigned long long**)calloc(n + 1, sizeof(unsigned long long*));
+    unsigned long long **best = (unsigned long long**)calloc(n + 1, sizeof(unsigned long long*));
+    unsigned long long *fp = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+    unsigned long long *dfp = (unsigned long long*)calloc(n + 1, sizeof(unsigned long long));
+    unsigned long long *aux = (unsigned long long*)calloc(2 * n + 2, sizeof(unsigned long long));
+    int *degs = (int*)calloc(n + 1, sizeof(int));
+    int *bestDegs = (int*)calloc(n + 1, sizeof(int));
+
+    if(result == NULL || facs == NULL || best == NULL || fp == NULL || dfp == NULL || aux == NULL || degs == NULL || bestDegs == NULL){
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    int r = 0, tries = 0;
+    unsigned long long prime = 0;
+
+    *numFactors = 0;
+
+    for(unsigned long long q = 3; n > 1 && tries < ZASSENHAUS_PRIMES && q < ZASSENHAUS_PRIME_LIMIT; q += 2){
+
+        if(!isPrime(q) || f[n] % (long long)q == 0) continue;
+
+        for(int i = 0; i <= n; i++) fp[i] = (unsigned long long)(f[i] % (long long)q + (long long)q) % q;
+        for(int i = 1; i <= n; i++) dfp[i-1] = mulMod(fp[i], i % q, q);
+
+        if(mpGcd(fp, n, dfp, mpTrim(dfp, n - 1), q, aux) != 0) continue;
+
+        gfPolynomial fq = gfCreate(n, q);
+
+        for(int i = 0; i <= n; i++) fq.coef[i] = fp[i];
+
+        int count = 0;
+        gfPolynomial *modFactors = gfFactor(fq, &count);
+
+        for(int i = 0; i < count; i++){
+
+            facs[i] = modFactors[i].coef;
+            degs[i] = modFactors[i].degree;
+        }
+
+        gfFree(fq);
+        free(modFactors);
+
+        tries++;
+
+        if(prime == 0 || count < r){
+
+            for(int i = 0; i < r; i++) free(best[i]);
+            for(int i = 0; i < count; i++){
+
+                best[i] = facs[i];
+                bestDegs[i] = degs[i];
+            }
+
+            r = count;
+            prime = q;
+        }
+        else{
+
+            for(int i = 0; i < count; i++) free(facs[i]);
+        }
+
+        if(r == 1) break;
+    }
+
+    double normF = 0;
+
+    for(int i = 0; i <= n; i++) normF = (fabs((double)f[i]) > normF) ? fabs((double)f[i]) : normF;
+
+    double bound = n + 0.5 * log2(n + 1.0) + log2(normF) + log2(fabs((double)f[n])) + 1;
+    unsigned long long M = prime;
+
+    while(prime != 0 && (log2((double)M) <= bound || r > VANHOEIJ_THRESHOLD) && log2((double)M) + log2((double)prime) < 62) M *= prime;
+
+    if(r > 1){
+
+        long long lc = f[n];
+        int dcur = n;
+
+        for(int i = 0; i <= n; i++) fp[i] = (unsigned long long)(f[i] % (long long)M + (long long)M) % M;
+
+        unsigned long long inv = mpInv(fp[n], M);
+
+        for(int i = 0; i <= n; i++) fp[i] = mulMod(fp[i], inv, M);
+
+        henselMulti(fp, n, best, bestDegs, 0, r, prime, M);
+
+        int *live = (int*)malloc(r * sizeof(int));
+        int *comb = (int*)malloc(r * sizeof(int));
+        int *pick = (int*)malloc(r * sizeof(int));
+        int *group = (int*)malloc(r * sizeof(int));
+        long long *g = (long long*)calloc(n + 1, sizeof(long long));
+        long long *quot = (long long*)calloc(n + 1, sizeof(long long));
+
+        if(live == NULL || comb == NULL || pick == NULL || group == NULL || g == NULL || quot == NULL){
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        int numLive = r, exhaustive = 1;
+
+        for(int i = 0; i < r; i++) live[i] = i;
+
+        if(r > VANHOEIJ_THRESHOLD){
+
+            int groups = vanHoeij(f, dcur, best, bestDegs, live, numLive, M, group);
+
+            for(int k = 0; k < groups; k++){
+
+                int s = 0;
+
+                for(int i = 0; i < numLive; i++) if(group[i] == k) pick[s++] = live[i];
+
+                int dg = zpFromLifted(best, bestDegs, pick, s, lc, M, aux, g);
+
+                zpDivExact(f, dcur, g, dg, quot);
+
+                result[(*numFactors)++] = zpToPoly(g, dg);
+                dcur -= dg;
+
+                for(int i = 0; i <= dcur; i++) f[i] = quot[i];
+            }
+
+            if(groups > 0) numLive = 0;
+
+            exhaustive = (numLive <= VANHOEIJ_THRESHOLD);
+        }
+
+        for(int s = 1; exhaustive && 2 * s <= numLive; ){
+
+            int found = 0;
+
+            for(int i = 0; i < s; i++) comb[i] = i;
+
+            while(!found){
+
+                unsigned long long c = (unsigned long long)(lc % (long long)M + (long long)M) % M;
+
+                for(int i = 0; i < s; i++) c = mulMod(c, best[live[comb[i]]][0], M);
+
+                __int128 cs = (c > M / 2) ? (__int128)c - M : (__int128)c;
+
+                if(cs != 0 && ((__int128)lc * f[0]) % cs == 0){
+
+                    for(int i = 0; i < s; i++) pick[i] = live[comb[i]];
+
+                    int dg = zpFromLifted(best, bestDegs, pick, s, lc, M, aux, g);
+
+                    if(zpDivExact(f, dcur, g, dg, quot)){
+
+                        result[(*numFactors)++] = zpToPoly(g, dg);
+                        dcur -= dg;
+
+                        for(int i = 0; i <= dcur; i++) f[i] = quot[i];
+
+                        lc = f[dcur];
+
+                        int kept = 0;
+
+                        for(int i = 0, j = 0; i < numLive; i++){
+
+                            if(j < s && comb[j] == i) j++;
+                            else live[kept++] = live[i];
+                        }
+
+                        numLive = kept;
+                        found = 1;
+                        break;
+                    }
+                }
+
+                int i = s - 1;
+
+                while(i >= 0 && comb[i] == numLive - s + i) i--;
+
+                if(i < 0) break;
+
+                comb[i]++;
+
+                for(int j = i + 1; j < s; j++) comb[j] = comb[j-1] + 1;
+            }
+
+            if(!found) s++;
+        }
+
+        n = dcur;
+
+        free(live);
+        free(comb);
+        free(pick);
+        free(group);
+        free(g);
+        free(quot);
+    }
+
+    if(n > 0) result[(*numFactors)++] = zpToPoly(f, n);
+
+    for(int i = 0; i < r; i++) free(best[i]);
+
+    free(f);
+    free(facs);
+    free(best);
+    free(fp);
+    free(dfp);
+    free(aux);
+    free(degs);
+    free(bestDegs);
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+void printRoot(double complex z){
+
+    double real = creal(z);
+    double imag = cimag(z);
+
+    if (fabs(real) < 1e-4) real = 0.0;
+    if (fabs(imag) < 1e-4) imag = 0.0;
+
+    if (imag == 0.0) printf("(%c %c %.6f)", var, (real >= 0) ? '-' : '+', fabs(real));
+    else if (real == 0.0) printf("(%c %c %.6fi)", var, (imag >= 0) ? '-' : '+', fabs(imag));
+    else printf("(%c - (%.6f %c %.6fi))", var, real, (imag >= 0) ? '+' : '-', fabs(imag));
+}
+
+//-----------------------------------------------------------------------------
+
+double complex polishRoot(const double* coef, int deg, double complex z){
+
+    for (int iter = 0; iter < 2; iter++) {
+
+        double complex pVal = coef[0];
+        double complex pDer = 0.0;
+
+        for (int j = 1; j <= deg; j++) {
+
+            pDer = pDer * z + pVal;
+            pVal = pVal * z + coef[j];
+        }
+
+        if (pDer == 0.0) break;
+
+        z -= pVal / pDer;
+    }
+
+    return z;
+}
+
+//-----------------------------------------------------------------------------
+
+void cubicRoots(const double* coef, double complex* roots){
+
+    double b = coef[1] / coef[0];
+    double c = coef[2] / coef[0];
+    double d = coef[3] / coef[0];
+    double p = c - b * b / 3.0;
+    double q = 2.0 * b * b * b / 27.0 - b * c / 3.0 + d;
+    double delta = q * q / 4.0 + p * p * p / 27.0;
+
+    if (delta > 0.0) {
+
+        double u = cbrt(-q / 2.0 - copysign(sqrt(delta), q));
+        double v = (u != 0.0) ? -p / (3.0 * u) : 0.0;
+
+        roots[0] = u + v;
+        roots[1] = -(u + v) / 2.0 + I * (sqrt(3.0) / 2.0) * (u - v);
+        roots[2] = conj(roots[1]);
+    }
+    else if (p == 0.0) {
+
+        roots[0] = roots[1] = roots[2] = 0.0;
+    }
+    else {
+
+        double r = 2.0 * sqrt(-p / 3.0);
+        double arg = (3.0 * q / (2.0 * p)) * sqrt(-3.0 / p);
+        double phi = acos((arg > 1.0) ? 1.0 : (arg < -1.0) ? -1.0 : arg);
+
+        for (int k = 0; k < 3; k++) roots[k] = r * cos(phi / 3.0 - 2.0 * M_PI * k / 3.0);
+    }
+
+    for (int k = 0; k < 3; k++) roots[k] = polishRoot(coef, 3, roots[k] - b / 3.0);
+}
+
+//-----------------------------------------------------------------------------
+
+int printCubicRadicals(long long a, long long b, long long c, long long d){
+
+    __int128 D = (__int128)18 * a * b * c * d - (__int128)4 * b * b * b * d + (__int128)b * b * c * c
+               - (__int128)4 * a * c * c * c - (__int128)27 * a * a * d * d;
+    __int128 N = (__int128)2 * b * b * b - (__int128)9 * a * b * c + (__int128)27 * a * a * d;
+    __int128 E = (__int128)b * b - (__int128)3 * a * c;
+
+    if (D == 0 || D > LLONG_MAX / 3 || D < LLONG_MIN / 3 || N > LLONG_MAX || N < -LLONG_MAX || E > LLONG_MAX) return 0;
+
+    long long den = 3 * a;
+    char lead[32] = "";
+
+    if (b != 0) snprintf(lead, sizeof(lead), "%lld ", -b);
+
+    if (D < 0) {
+
+        char plus[128], minus[128];
+
+        snprintf(plus, sizeof(plus), "CubeRoot[(%lld + %lldSqrt[%lld])/2]", -(long long)N, 3 * a, -3 * (long long)D);
+        snprintf(minus, sizeof(minus), "CubeRoot[(%lld - %lldSqrt[%lld])/2]", -(long long)N, 3 * a, -3 * (long long)D);
+
+        printf("(%c - (%s%s%s + %s)/%lld)", var, lead, (b != 0) ? "+ " : "", plus, minus, den);
+        printf("(%c - (%s- (%s + %s)/2 + iSqrt[3](%s - %s)/2)/%lld)", var, lead, plus, minus, plus, minus, den);
+        printf("(%c - (%s- (%s + %s)/2 - iSqrt[3](%s - %s)/2)/%lld)", var, lead, plus, minus, plus, minus, den);
+    }
+    else {
+
+        for (int k = 0; k < 3; k++) {
+
+            printf("(%c - (%s%s2Sqrt[%lld]Cos[(ArcCos[%lld/(2*%lld^(3/2))]", var, lead, (b != 0) ? "+ " : "", (long long)E, -(long long)N, (long long)E);
+
+            if (k > 0) printf(" - %d*Pi", 2 * k);
+
+            printf(")/3])/%lld)", den);
+        }
+    }
+
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void cardano(polynomial p){
+
+    if(pHasBig(p)){
+
+        aberth(p);
+        return;
+    }
+
+    long long a = p.terms[0].coefficient, b = p.terms[1].coefficient;
+    long long c = p.terms[2].coefficient, d = p.terms[3].coefficient;
+
+    if (a < 0) {
+
+        a = -a;
+        b = -b;
+        c = -c;
+        d = -d;
+    }
+
+    if (radicals && printCubicRadicals(a, b, c, d)) return;
+
+    double coef[4] = {(double)a, (double)b, (double)c, (double)d};
+    double complex roots[3];
+
+    cubicRoots(coef, roots);
+
+    for (int k = 0; k < 3; k++) printRoot(roots[k]);
+}
+
+//-----------------------------------------------------------------------------
+
+void ferrari(polynomial p){
+
+    if(pHasBig(p)){
+
+        aberth(p);
+        return;
+    }
+
+    double coef[5];
+    double complex roots[4];
+
+    for (int i = 0; i <= 4; i++) coef[i] = p.terms[i].coefficient;
+
+    double b = coef[1] / coef[0];
+    double c = coef[2] / coef[0];
+    double d = coef[3] / coef[0];
+    double e = coef[4] / coef[0];
+    double P = c - 3.0 * b * b / 8.0;
+    double Q = d - b * c / 2.0 + b * b * b / 8.0;
+    double R = e - b * d / 4.0 + b * b * c / 16.0 - 3.0 * b * b * b * b / 256.0;
+    __int128 qNum = (__int128)p.terms[1].coefficient * p.terms[1].coefficient * p.terms[1].coefficient
+                  - (__int128)4 * p.terms[0].coefficient * p.terms[1].coefficient * p.terms[2].coefficient
+                  + (__int128)8 * p.terms[0].coefficient * p.terms[0].coefficient * p.terms[3].coefficient;
+
+    if (qNum == 0) {
+
+        double complex disc = csqrt(P * P - 4.0 * R);
+        double complex z[2] = {(-P + disc) / 2.0, (-P - disc) / 2.0};
+
+        for (int k = 0; k < 2; k++) {
+
+            roots[2 * k] = csqrt(z[k]);
+            roots[2 * k + 1] = -roots[2 * k];
+        }
+    }
+    else {
+
+        double resolvent[4] = {8.0, 8.0 * P, 2.0 * P * P - 8.0 * R, -Q * Q};
+        double complex m3[3];
+        double m = 0.0;
+
+        cubicRoots(resolvent, m3);
+
+        for (int k = 0; k < 3; k++) {
+
+            if (fabs(cimag(m3[k])) < 1e-9 && creal(m3[k]) > m) m = creal(m3[k]);
+        }
+
+        double s = sqrt(2.0 * m);
+        double complex disc1 = csqrt(s * s - 4.0 * (P / 2.0 + m + Q / (2.0 * s)));
+        double complex disc2 = csqrt(s * s - 4.0 * (P / 2.0 + m - Q / (2.0 * s)));
+
+        roots[0] = (s + disc1) / 2.0;
+        roots[1] = (s - disc1) / 2.0;
+        roots[2] = (-s + disc2) / 2.0;
+        roots[3] = (-s - disc2) / 2.0;
+    }
+
+    for (int k = 0; k < 4; k++) printRoot(polishRoot(coef, 4, roots[k] - b / 4.0));
+}
+
+//-----------------------------------------------------------------------------
+
+void aberthRoots(const double complex* coef, int deg, double complex* roots){
+
+    int converge = 0;
+    double R = 1.0, val = 0.0, angle = 0.0;
+    double complex pVal = 0.0, pDer = 0.0, sum = 0.0, q = 0.0, adjustment = 0.0, newRoot = 0.0;
+
+    R = 0.0;
+
+    for (int i = 1; i <= deg; i++) {
+
+        val = pow(cabs(coef[i] / coef[0]), 1.0 / i);
+        if (val > R) R = val;
+    }
+
+    R = 2.0 * R + 1e-3;
+
+    for (int i = 0; i < deg; i++) {
+
+        angle = 2.0 * M_PI * i / deg;
+        roots[i] = R * (cos(angle) + I * sin(angle));
+    }
+
+    for (int iter = 0; iter < ABERTH_ITERS; iter++) {
+
+        converge = 1;
+
+        for (int i = 0; i < deg; i++) {
+
+            pVal = coef[0];
+            pDer = coef[0] * deg;
+
+            for (int j = 1; j < deg; j++) {
+
+                pVal = pVal * roots[i] + coef[j];
+                pDer = pDer * roots[i] + coef[j] * (deg - j);
+            }
+
+            pVal = pVal * roots[i] + coef[deg];
+
+            sum = 0.0;
+
+            for (int j = 0; j < deg; j++) {
+
+                if (j != i) sum += 1.0 / (roots[i] - roots[j]);
+            }
+
+            q = pVal / pDer;
+
+            adjustment = q / (1.0 - q * sum);
+
+            newRoot = roots[i] - adjustment;
+
+            if (cabs(newRoot - roots[i]) > 1e-12) converge = 0;
+
+            roots[i] = newRoot;
+        }
+
+        if (converge) break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int decomposeExact(const bigInt* exact, int n, int s){
+
+    int r = n / s;
+    int ok = 0;
+
+    // p = g(h) with h monic over Q turns into an integer H for the monic
+    // P(x) = C^n p(x / C) / lc and H(x) = C^s h(x / C): C = 1 is enough for
+    // most inputs and keeps the numbers small, C = r^2 lc works whenever p
+    // decomposes at all
+    for (int attempt = 0; attempt < 2 && !ok; attempt++) {
+
+        bigInt c, power, t, rest;
+        bigInt *P = bigsCreate(n + 1);
+        bigInt *H = bigsCreate(s + 1);
+
+        ok = 1;
+        bigInit(&c, attempt ? (long long)r * r : 1);
+        bigInit(&power, 1);
+        bigInit(&rest, 0);
+
+        if (attempt) bigMul(&c, &exact[0]);
+
+        for (int k = 0; k <= n && ok; k++) {
+
+            bigInit(&t, 0);
+            bigAddProduct(&t, &exact[k], &power);
+            bigDivMod(&t, &exact[0], &P[k], &rest);
+            bigFree(&t);
+
+            if (rest.sign != 0) ok = 0;
+
+            bigMul(&power, &c);
+        }
+
+        // top coefficients of H^r = P by J. C. P. Miller's power recurrence;
+        // the division by k is always exact, the one by r only if H is integer
+        bigAddMul(&H[0], &P[0], 1);
+
+        for (int k = 1; k < s && ok; k++) {
+
+            bigInit(&t, 0);
+
+            for (int j = 1; j < k; j++) {
+
+                bigInt hp;
+
+                bigInit(&hp, 0);
+                bigAddProduct(&hp, &H[j], &P[k - j]);
+                bigAddMul(&t, &hp, (long long)(r + 1) * j - k);
+                bigFree(&hp);
+            }
+
+            bigDivSmall(&t, k);
+            bigAddMul(&H[k], &P[k], 1);
+            bigAddMul(&H[k], &t, -1);
+            bigFree(&t);
+
+            if (bigModSmall(&H[k], r) != 0) ok = 0;
+            else bigDivSmall(&H[k], r);
+        }
+
+        // H-adic expansion of P, the same long division decompose runs on
+        // doubles: every remainder has to be a constant
+        for (int j = 1; j < s; j++) H[j].sign = -H[j].sign;
+
+        for (int i = 0; i < r && ok; i++) {
+
+            int d = (r - i) * s;
+
+            for (int k = 0; k <= d - s; k++) {
+
+                for (int j = 1; j < s; j++) bigAddProduct(&P[k + j], &P[k], &H[j]);
+            }
+
+            for (int k = d - s + 1; k < d; k++) {
+
+                if (P[k].sign != 0) ok = 0;
+            }
+        }
+
+        bigFree(&c);
+        bigFree(&power);
+        bigFree(&rest);
+        bigsFree(P, n + 1);
+        bigsFree(H, s + 1);
+    }
+
+    return ok;
 }
 
 //-----------------------------------------------------------------------------
 
-void divideX(polynomial p) {
+int decompose(const double* coef, const bigInt* exact, int n, int s, double complex* g, double complex* h){
 
-    int minExp = p.terms[0].exponent;
+    int r = n / s;
+    int ok = 1;
+    long double scale = 0.0L;
+    long double *u = NULL, *v = NULL, *rem = NULL;
 
-    for (int i = 1; i < p.numTerms; i++) {
+    u = (long double*)malloc(s * sizeof(long double));
+    v = (long double*)malloc(s * sizeof(long double));
+    rem = (long double*)malloc((n + 1) * sizeof(long double));
 
-        if (p.terms[i].exponent < minExp) minExp = p.terms[i].exponent;
+    if (u == NULL || v == NULL || rem == NULL) {
+
+        printf("\nError allocating memory.");
+        exit(1);
     }
 
-    polynomial remainder = pCreate(p.numTerms);
+    for (int k = 0; k <= n; k++) {
 
-    for (int i = 0; i < p.numTerms; i++) {
+        rem[k] = (long double)coef[k] / coef[0];
+        if (fabsl(rem[k]) > scale) scale = fabsl(rem[k]);
+    }
+
+    for (int k = 0; k < s; k++) u[k] = rem[k];
+
+    v[0] = 1.0L;
+
+    for (int k = 1; k < s; k++) {
 
-        remainder.terms[i] = setTerms(p.terms[i].coefficient, p.terms[i].exponent - minExp);
+        long double acc = 0.0L;
+
+        for (int j = 1; j <= k; j++) acc += ((1.0L / r + 1.0L) * j - k) * u[j] * v[k - j];
+
+        v[k] = acc / k;
     }
 
-    removeZeros(&remainder);
+    for (int i = 0; i < r && ok; i++) {
 
-    degreeX = minExp;
+        int d = (r - i) * s;
 
-    fac(remainder);
+        for (int k = 0; k <= d - s; k++) {
+
+            for (int j = 1; j < s; j++) {
+
+                long double t = rem[k] * v[j];
+
+                if (fabsl(t) > scale) scale = fabsl(t);
+                rem[k + j] -= t;
+            }
+        }
+
+        for (int k = d - s + 1; k < d; k++) {
+
+            if (fabsl(rem[k]) > 1e-12L * scale) ok = 0;
+        }
+
+        g[r - i] = (double)(rem[d] * coef[0]);
+    }
+
+    if (ok) ok = decomposeExact(exact, n, s);
 
-    free(remainder.terms);
+    if (ok) {
+
+        g[0] = coef[0];
+
+        for (int k = 0; k < s; k++) h[k] = (double)v[k];
+
+        h[s] = 0.0;
+    }
+
+    free(u);
+    free(v);
+    free(rem);
+
+    return ok;
 }
 
 //-----------------------------------------------------------------------------
 
-void divideGCD(polynomial p){
+void compositeRoots(const double* coef, const bigInt* exact, int n, double complex* roots){
+
+    int s = 0, r = 0;
+    double complex *g = NULL, *h = NULL, *gRoots = NULL;
 
-    divider = p.terms[0].coefficient;
+    for (s = 2; s <= n / 2; s++) {
 
-    for (int i = 1; i < p.numTerms; i++){
+        if (n % s != 0) continue;
 
-        divider = gcd(divider, p.terms[i].coefficient);
+        g = (double complex*)malloc((n / s + 1) * sizeof(double complex));
+        h = (double complex*)malloc((s + 1) * sizeof(double complex));
+
+        if (g == NULL || h == NULL) {
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        if (decompose(coef, exact, n, s, g, h)) break;
+
+        free(g);
+        free(h);
+        g = NULL;
+        h = NULL;
     }
 
-    for (int j = 0; j < p.numTerms; j++){
+    if (g == NULL) {
+
+        g = (double complex*)malloc((n + 1) * sizeof(double complex));
+
+        if (g == NULL) {
+
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        for (int i = 0; i <= n; i++) g[i] = coef[i];
+
+        aberthRoots(g, n, roots);
+
+        free(g);
+
+        return;
+    }
 
-        p.terms[j].coefficient /= divider;
+    r = n / s;
+    gRoots = (double complex*)malloc(r * sizeof(double complex));
+
+    if (gRoots == NULL) {
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    aberthRoots(g, r, gRoots);
+
+    for (int i = 0; i < r; i++) {
+
+        h[s] = -gRoots[i];
+        aberthRoots(h, s, roots + i * s);
     }
+
+    free(g);
+    free(h);
+    free(gRoots);
 }
 
 //-----------------------------------------------------------------------------
 
-void aberth(polynomial p) {
+int reciprocalRoots(const double* coef, int n, double complex* roots){
 
-    int aexp = p.terms[0].exponent;
-    int converge = 0;
-    double R = 1.0, real = 0.0, imag = 0.0, val = 0.0, angle = 0.0;
-    double complex pVal = 0.0, pDer = 0.0, sum = 0.0, q = 0.0, adjustment = 0.0, newRoot = 0.0;
-    double *coef = NULL;
-    double complex *roots = NULL;
+    int m = n / 2;
+    int ok = 1;
+    long long *prev = NULL, *cur = NULL, *next = NULL, *q = NULL;
+    double *qCoef = NULL;
+    double complex *yRoots = NULL;
 
-    coef = (double*)calloc(aexp + 1, sizeof(double));
+    if (n < 4 || n % 2 != 0) return 0;
 
-    for (int i = 0; i < p.numTerms; i++) {
+    for (int i = 0; i < m; i++) {
+
+        if (coef[i] != coef[n - i]) return 0;
+    }
+
+    prev = (long long*)calloc(m + 1, sizeof(long long));
+    cur = (long long*)calloc(m + 1, sizeof(long long));
+    next = (long long*)calloc(m + 1, sizeof(long long));
+    q = (long long*)calloc(m + 1, sizeof(long long));
 
-        int exp = p.terms[i].exponent;
+    if (prev == NULL || cur == NULL || next == NULL || q == NULL) {
 
-        if (exp >= 0 && exp <= aexp) coef[aexp - exp] = p.terms[i].coefficient;
+        printf("\nError allocating memory.");
+        exit(1);
     }
 
-    for (int i = 1; i <= aexp; i++) {
+    // x^-m p(x) = a_0 + sum a_k (x^k + x^-k), with x^k + x^-k = D_k(x + 1/x)
+    // and the Dickson polynomials D_0 = 2, D_1 = y, D_k = y D_(k-1) - D_(k-2)
+    prev[0] = 2;
+    cur[1] = 1;
+    q[0] = (long long)coef[m];
 
-        val = fabs(coef[i] / coef[0]);
-        if (val > R) R = val;
+    for (int k = 1; k <= m && ok; k++) {
+
+        long long a = (long long)coef[m - k];
+
+        for (int i = 0; i <= k && ok; i++) {
+
+            long long t = 0;
+
+            if (__builtin_mul_overflow(a, cur[i], &t) || __builtin_add_overflow(q[i], t, &q[i])) ok = 0;
+        }
+
+        if (k == m || !ok) break;
+
+        for (int i = 0; i <= k + 1; i++) {
+
+            long long t = (i > 0) ? cur[i - 1] : 0;
+
+            if (__builtin_sub_overflow(t, prev[i], &next[i])) ok = 0;
+        }
+
+        long long* tmp = prev;
+        prev = cur;
+        cur = next;
+        next = tmp;
     }
 
-    R += 1.0;
+    if (ok) {
 
-    roots = malloc(aexp * sizeof(double complex));
+        qCoef = (double*)malloc((m + 1) * sizeof(double));
+        yRoots = (double complex*)malloc(m * sizeof(double complex));
 
-    for (int i = 0; i < aexp; i++) {
+        if (qCoef == NULL || yRoots == NULL) {
 
-        angle = 2.0 * M_PI * i / aexp;
-        roots[i] = R * (cos(angle) + I * sin(angle));
+            printf("\nError allocating memory.");
+            exit(1);
+        }
+
+        bigInt *qExact = bigsCreate(m + 1);
+
+        for (int i = 0; i <= m; i++) {
+
+            qCoef[i] = (double)q[m - i];
+            bigFree(&qExact[i]);
+            bigInit(&qExact[i], q[m - i]);
+        }
+
+        compositeRoots(qCoef, qExact, m, yRoots);
+        bigsFree(qExact, m + 1);
+
+        // x^2 - y x + 1 = 0: the root of larger modulus and its pair 1 / x,
+        // both refined on p since q loses accuracy as m grows
+        for (int i = 0; i < m; i++) {
+
+            double complex y = yRoots[i];
+            double complex d = csqrt(y * y - 4.0);
+            double complex x = (cabs(y + d) >= cabs(y - d)) ? (y + d) / 2.0 : (y - d) / 2.0;
+
+            roots[2 * i] = polishRoot(coef, n, x);
+            roots[2 * i + 1] = polishRoot(coef, n, 1.0 / x);
+        }
+
+        free(qCoef);
+        free(yRoots);
     }
 
-    for (int iter = 0; iter < ABERTH_ITERS; iter++) {
+    free(prev);
+    free(cur);
+    free(next);
+    free(q);
 
-        converge = 1;
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
 
-        for (int i = 0; i < aexp; i++) {
+double complex sparseNewtonStep(const double* c, const int* e, int t, double complex z){
 
-            pVal = coef[0];
-            pDer = coef[0] * aexp;
+    double lz = log(cabs(z));
+    double az = carg(z);
+    double w[FEWNOMIAL_TERMS];
+    double M = -HUGE_VAL;
+    double complex P = 0.0, D = 0.0;
 
-            for (int j = 1; j < aexp; j++) {
+    // Every term is scaled by the largest |c_k z^e_k| so x^e never overflows
+    for (int k = 0; k < t; k++) {
 
-                pVal = pVal * roots[i] + coef[j];
-                pDer = pDer * roots[i] + coef[j] * (aexp - j);
-            }
+        w[k] = log(fabs(c[k])) + e[k] * lz;
+        if (w[k] > M) M = w[k];
+    }
 
-            pVal = pVal * roots[i] + coef[aexp];
+    for (int k = 0; k < t; k++) {
 
-            sum = 0.0;
+        double complex T = copysign(exp(w[k] - M), c[k]) * cexp(I * (e[k] * az));
 
-            for (int j = 0; j < aexp; j++) {
+        P += T;
+        D += e[k] * T;
+    }
 
-                if (j != i) sum += 1.0 / (roots[i] - roots[j]);
+    if (D == 0.0) return 0.0;
+
+    return z * P / D;
+}
+
+//-----------------------------------------------------------------------------
+
+int cmpReal(const void* a, const void* b){
+
+    double x = creal(*(const double complex*)a);
+    double y = creal(*(const double complex*)b);
+
+    return (x > y) - (x < y);
+}
+
+//-----------------------------------------------------------------------------
+
+int fewnomialRoots(const double* coef, int n, double complex* roots){
+
+    int t = 0, top = 0, filled = 0, pending = 0, ok = 1;
+    int e[FEWNOMIAL_TERMS];
+    int hull[FEWNOMIAL_TERMS];
+    double c[FEWNOMIAL_TERMS];
+    double L[FEWNOMIAL_TERMS];
+    int *width = NULL, *converged = NULL;
+    double complex *start = NULL, *sorted = NULL;
+
+    // The phase e_k * arg(z) carries a rounding error that grows with e_k
+    double eps = 1e-14 + 1e-15 * n;
+
+    if (n < FEWNOMIAL_MIN_DEGREE || coef[n] == 0.0) return 0;
+
+    for (int i = n; i >= 0; i--) {
+
+        if (coef[i] == 0.0) continue;
+        if (t == FEWNOMIAL_TERMS) return 0;
+
+        e[t] = n - i;
+        c[t] = coef[i];
+        L[t] = log(fabs(coef[i]));
+        t++;
+    }
+
+    width = (int*)malloc(n * sizeof(int));
+    converged = (int*)calloc(n, sizeof(int));
+    start = (double complex*)malloc(n * sizeof(double complex));
+    sorted = (double complex*)malloc(n * sizeof(double complex));
+
+    if (width == NULL || converged == NULL || start == NULL || sorted == NULL) {
+
+        printf("\nError allocating memory.");
+        exit(1);
+    }
+
+    // Upper convex hull of (e_k, log|c_k|): each edge a -> b holds e_b - e_a
+    // roots of modulus close to (|c_a| / |c_b|)^(1 / (e_b - e_a))
+    for (int k = 0; k < t; k++) {
+
+        while (top >= 2) {
+
+            int a = hull[top - 2], b = hull[top - 1];
+            double cross = (e[b] - e[a]) * (L[k] - L[a]) - (L[b] - L[a]) * (e[k] - e[a]);
+
+            if (cross < 0.0) break;
+            top--;
+        }
+
+        hull[top++] = k;
+    }
+
+    // Starting points from the binomial c_a x^e_a + c_b x^e_b of each edge
+    for (int h = 0; h + 1 < top; h++) {
+
+        int a = hull[h], b = hull[h + 1];
+        int m = e[b] - e[a];
+        double rho = exp((L[a] - L[b]) / m);
+        double phase = (c[a] / c[b] > 0.0) ? M_PI : 0.0;
+
+        for (int k = 0; k < m; k++) {
+
+            double angle = (phase + 2.0 * M_PI * k) / m;
+
+            width[filled] = m;
+            start[filled] = rho * (cos(angle) + I * sin(angle));
+            roots[filled] = start[filled];
+            filled++;
+        }
+    }
+
+    // Independent Newton steps cost O(t) each, kept under a quarter of the
+    // spacing between the m roots of the edge so they stay in their basin
+    for (int i = 0; i < n; i++) {
+
+        for (int iter = 0; iter < FEWNOMIAL_ITERS && !converged[i]; iter++) {
+
+            double complex step = sparseNewtonStep(c, e, t, roots[i]);
+            double limit = M_PI * cabs(roots[i]) / (2.0 * width[i]);
+
+            if (cabs(step) > limit) step *= limit / cabs(step);
+
+            roots[i] -= step;
+
+            if (!isfinite(creal(roots[i])) || !isfinite(cimag(roots[i])) || roots[i] == 0.0) break;
+            if (cabs(step) <= eps * cabs(roots[i])) converged[i] = 1;
+        }
+
+        if (!converged[i]) roots[i] = start[i];
+    }
+
+    // Roots that did not converge, or landed on a root already taken, go
+    // through Aberth's correction, whose repulsion term keeps them apart
+    for (int pass = 0; pass < 2 && ok; pass++) {
+
+        for (int i = 0; i < n; i++) sorted[i] = roots[i];
+
+        qsort(sorted, n, sizeof(double complex), cmpReal);
+
+        pending = 0;
+
+        for (int i = 0; i < n; i++) pending += !converged[i];
+
+        for (int i = 0; i < n; i++) {
+
+            double tol = 1e-8 * fmax(1.0, cabs(sorted[i]));
+
+            for (int j = i + 1; j < n && creal(sorted[j]) - creal(sorted[i]) <= tol; j++) {
+
+                if (cabs(sorted[j] - sorted[i]) <= tol) {
+
+                    // The second copy is sent back to its starting point
+                    for (int k = 0; k < n; k++) {
+
+                        if (converged[k] && roots[k] == sorted[j]) {
+
+                            converged[k] = 0;
+                            roots[k] = start[k];
+                            pending++;
+                            break;
+                        }
+                    }
+                }
             }
+        }
 
-            q = pVal / pDer;
+        if (pending == 0) break;
 
-            adjustment = q / (1.0 - q * sum);
+        if (pass == 1) {
 
-            newRoot = roots[i] - adjustment;
+            ok = 0;
+            break;
+        }
 
-            if (cabs(newRoot - roots[i]) > 1e-12) converge = 0;
+        for (int iter = 0; iter < ABERTH_ITERS && pending > 0; iter++) {
 
-            roots[i] = newRoot;
+            for (int i = 0; i < n; i++) {
+
+                if (converged[i]) continue;
+
+                double complex q = sparseNewtonStep(c, e, t, roots[i]);
+                double complex sum = 0.0;
+
+                for (int j = 0; j < n; j++) {
+
+                    if (j != i) sum += 1.0 / (roots[i] - roots[j]);
+                }
+
+                double complex adjustment = q / (1.0 - q * sum);
+
+                roots[i] -= adjustment;
+
+                if (!isfinite(creal(roots[i])) || !isfinite(cimag(roots[i]))) {
+
+                    ok = 0;
+                    break;
+                }
+
+                if (cabs(adjustment) <= eps * cabs(roots[i])) {
+
+                    converged[i] = 1;
+                    pending--;
+                }
+            }
+
+            if (!ok) break;
         }
+    }
 
-        if (converge) break;
+    free(width);
+    free(converged);
+    free(start);
+    free(sorted);
+
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+
+void aberth(polynomial p) {
+
+    int aexp = p.terms[0].exponent;
+    int step = 0;
+    double angle = 0.0;
+    double *coef = NULL;
+    bigInt *exact = NULL;
+    double complex *roots = NULL;
+    double complex *expanded = NULL;
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        if (p.terms[i].coefficient != 0) step = gcd(step, p.terms[i].exponent);
+    }
+
+    if (step < 1) step = 1;
+
+    aexp /= step;
+
+    coef = (double*)calloc(aexp + 1, sizeof(double));
+    exact = bigsCreate(aexp + 1);
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        int exp = p.terms[i].exponent / step;
+
+        if (exp >= 0 && exp <= aexp) {
+
+            coef[aexp - exp] = (p.terms[i].big != NULL) ? bigToDouble(p.terms[i].big) : p.terms[i].coefficient;
+            bigFree(&exact[aexp - exp]);
+            termToBig(p.terms[i], &exact[aexp - exp]);
+        }
     }
 
-    printf("(");
+    roots = malloc(aexp * sizeof(double complex));
+
+    if (!reciprocalRoots(coef, aexp, roots) && !fewnomialRoots(coef, aexp, roots)) compositeRoots(coef, exact, aexp, roots);
+
+    bigsFree(exact, aexp + 1);
+
+    expanded = malloc(aexp * step * sizeof(double complex));
 
     for (int i = 0; i < aexp; i++) {
 
-        real = creal(roots[i]);
-        imag = cimag(roots[i]);
+        double radius = nrt(cabs(roots[i]), step);
 
-        if (fabs(real) < 1e-4) real = 0.0;
-        if (fabs(imag) < 1e-4) imag = 0.0;
+        for (int j = 0; j < step; j++) {
 
-        if (imag == 0.0) printf("(%c %c %.6f)", var, (real >= 0) ? '-' : '+', fabs(real));
-        else if (real == 0.0) printf("(%c %c %.6fi)", var, (imag >= 0) ? '-' : '+', fabs(imag));
-        else printf("(%c - (%.6f %c %.6fi))", var, real, (imag >= 0) ? '+' : '-', fabs(imag));
+            angle = (carg(roots[i]) + 2.0 * M_PI * j) / step;
+            expanded[i * step + j] = radius * (cos(angle) + I * sin(angle));
+        }
     }
 
-    printf(")");
+    for (int i = 0; i < aexp * step; i++) printRoot(expanded[i]);
 
     free(coef);
     free(roots);
+    free(expanded);
 }
 
 //-----------------------------------------------------------------------------
@@ -801,7 +9145,10 @@ void printFac(polynomial p){
 
     if(p.numTerms == 1 && p.terms[0].exponent == 0){
 
-        printf("%i\n\n", p.terms[0].coefficient);
+        if(p.terms[0].big != NULL) bigPrint(p.terms[0].big);
+        else printf("%i", p.terms[0].coefficient);
+
+        printf("\n\n");
         return;
     }
 
@@ -814,6 +9161,6 @@ void printFac(polynomial p){
 void pFree(polynomial p) {
 
     printFac(p);
-    free(p.terms);
+    termsFree(p.terms, p.numTerms);
     p.terms = NULL;
 }
@@ -21,7 +21,10 @@
  * @note Versão 1.0.0: Implementação inicial.
  * @note Versão 1.1.0: Adicionado método de Aberth e outras melhorias.
  * @note Versão 1.1.1: Correções e melhorias leves.
- * @note Versão 1.1.2: Correções e melhorias leves.
+ * @note Versão 1.1.2: Correções e melhorias leves.
+ *
+ * @note Requer GCC ou Clang: a implementação usa unsigned __int128 e as funções
+ *       __atomic, portanto o MSVC não é suportado.
  */
 
 #include <stdio.h>
@@ -45,24 +48,47 @@ extern int degreeX;
 /**
  * @brief Fator MDC extraído por divideGCD()
  */
-extern int divider;
+extern long long divider;
 
 /**
  * @brief Flag que indica se a fatoração foi completa (1) ou não (0)
  */
-extern int sol;
+extern int sol;
+
+/**
+ * @brief Flag para imprimir raízes de cúbicas como radicais exatos (1) em vez de decimais (0, padrão)
+ */
+extern int radicals;
 
-/**
- * @struct term
- * @brief Representa um único termo em um polinômio.
- *
- * Um termo é composto por um coeficiente e um expoente.
- * Por exemplo, o termo 3x² tem coeficiente = 3 e expoente = 2.
- */
-typedef struct sterm {
-    int coefficient; /**< O coeficiente do termo. */
-    int exponent;    /**< O expoente do termo. */
-} term;
+/**
+ * @struct bigInt
+ * @brief Inteiro de precisão arbitrária guardado como sinal e magnitude em limbs de 64 bits.
+ */
+typedef struct sbigint {
+    unsigned long long *limb; /**< Magnitude, limb menos significativo primeiro. */
+    int size;                 /**< Número de limbs em uso (0 para zero). */
+    int cap;                  /**< Número de limbs alocados. */
+    int sign;                 /**< -1, 0 ou 1. */
+} bigInt;
+
+/**
+ * @struct term
+ * @brief Representa um único termo em um polinômio.
+ *
+ * Um termo é composto por um coeficiente e um expoente.
+ * Por exemplo, o termo 3x² tem coeficiente = 3 e expoente = 2.
+ *
+ * Coeficientes entre -INT_MAX e INT_MAX ficam no próprio termo e big é NULL.
+ * Os maiores ficam em big, e coefficient passa a valer INT_MAX ou INT_MIN com o
+ * mesmo sinal, de modo que testes de sinal e de zero nele continuam válidos. Esse
+ * valor não é o coeficiente, então confira big (ou pHasBig()) antes de lê-lo
+ * como número.
+ */
+typedef struct sterm {
+    int coefficient; /**< O coeficiente do termo. */
+    int exponent;    /**< O expoente do termo. */
+    bigInt *big;     /**< Coeficiente no heap quando não cabe em um int, ou NULL. */
+} term;
 
 /**
  * @struct polynomial
@@ -72,8 +98,71 @@ typedef struct sterm {
  */
 typedef struct spolynomial {
     term *terms;        /**< Vetor dinâmico de termos do polinômio. */
-    int numTerms;       /**< Número de termos no polinômio. */
-} polynomial;
+    int numTerms;       /**< Número de termos no polinômio. */
+} polynomial;
+
+/**
+ * @struct gfPolynomial
+ * @brief Representa um polinômio denso sobre o corpo finito GF(p).
+ *
+ * coef[i] é o coeficiente de x^i, reduzido módulo p. O primo p deve ser menor que 2^62.
+ */
+typedef struct sgfpolynomial {
+    unsigned long long *coef; /**< Vetor dinâmico de coeficientes, indexado pelo expoente. */
+    int degree;               /**< Grau do polinômio (-1 para o polinômio nulo). */
+    unsigned long long p;     /**< Módulo primo. */
+} gfPolynomial;
+
+/**
+ * @struct rootInterval
+ * @brief Um intervalo [leftNum/leftDen, rightNum/rightDen] que isola uma raiz real.
+ *
+ * Os denominadores são positivos e as frações estão reduzidas. Quando as duas
+ * pontas coincidem, a raiz é exatamente esse racional; caso contrário, está
+ * estritamente no interior.
+ */
+typedef struct srootinterval {
+    long long leftNum;  /**< Numerador da ponta esquerda. */
+    long long leftDen;  /**< Denominador da ponta esquerda. */
+    long long rightNum; /**< Numerador da ponta direita. */
+    long long rightDen; /**< Denominador da ponta direita. */
+} rootInterval;
+
+/**
+ * @struct subproductTree
+ * @brief Produtos de (x - x_i) sobre metades de um conjunto fixo de pontos, para pEvalMulti() e pInterpolate().
+ *
+ * O nó 1 é o produto sobre todos os pontos e o nó i se divide nos nós 2i e 2i + 1.
+ * Segmentos de até TREE_LEAF_POINTS pontos são folhas e são avaliados
+ * diretamente. Os produtos ficam módulo primos de uma palavra, em ordem crescente
+ * e na forma de Montgomery. Os dos primeiros primos são guardados enquanto cabem
+ * em TREE_CACHE_WORDS palavras, e os demais são refeitos a cada chamada.
+ */
+typedef struct ssubproducttree {
+    int numPoints;               /**< Número de pontos. */
+    int *points;                 /**< Cópia dos pontos. */
+    int numNodes;                /**< Tamanho de cada tabela de produtos dos nós. */
+    int numPrimes;               /**< Número de primos cujos produtos são guardados. */
+    long long words;             /**< Palavras ocupadas pelos produtos guardados. */
+    unsigned long long next;     /**< Onde a busca pelo próximo primo recomeça. */
+    unsigned long long *modulus; /**< Os primos cujos produtos são guardados. */
+    unsigned long long *root;    /**< Não resíduo que gera as raízes da NTT de cada primo guardado. */
+    unsigned long long ***node;  /**< node[k][i] é o produto do nó i módulo modulus[k], ou NULL para índices sem uso. */
+    bigInt *weight;              /**< scale / M'(x_i), preenchido pela primeira pInterpolate(), ou NULL. */
+    bigInt scale;                /**< Mínimo múltiplo comum dos M'(x_i). */
+} subproductTree;
+
+/**
+ * @struct qPolynomial
+ * @brief Polinômio com coeficientes racionais num.terms[i] / den[i].
+ *
+ * Os numeradores são termos comuns, então depois de qPrimitive() num é o próprio
+ * polinômio inteiro e pode ser passado para fac(), printFac() ou qualquer função p*.
+ */
+typedef struct sqpolynomial {
+    polynomial num; /**< Termos com os numeradores e expoentes. */
+    int *den;       /**< Denominador não nulo de cada termo. */
+} qPolynomial;
 
 //-----------------------------------------------------------------------------
 /**
@@ -81,9 +170,34 @@ typedef struct spolynomial {
  *
  * @param coef O coeficiente do termo.
  * @param exp O expoente do termo.
- * @return O termo completo.
- */
-term setTerms(int coef, int exp);
+ * @return O termo completo.
+ */
+term setTerms(int coef, int exp);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Cria um termo cujo coeficiente é dado em decimal, de qualquer tamanho.
+ *
+ * O coeficiente é um sinal opcional seguido de dígitos; a leitura para no
+ * primeiro outro caractere. Ele fica no próprio termo quando cabe (veja term).
+ *
+ * @param coef O coeficiente, p. ex. "-123456789012345678901234567890".
+ * @param exp O expoente do termo.
+ * @return O termo completo (seu coeficiente no heap, se houver, é liberado por pFree()).
+ */
+term setBigTerms(const char* coef, int exp);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Indica se algum coeficiente de um polinômio está no heap.
+ *
+ * bhaskara(), cardano(), ferrari(), binomialFac() e irreducibleFac() trabalham com
+ * coeficientes de tamanho de máquina; elas fazem essa verificação antes e enviam
+ * um polinômio assim para aberth(). briotRuffini() a usa para passar à
+ * aritmética de vários limbs.
+ *
+ * @param p O polinômio.
+ * @return 1 se algum termo tem big não NULL, 0 caso contrário.
+ */
+int pHasBig(polynomial p);
 //-----------------------------------------------------------------------------
 /**
  * @brief Retorna a base de uma potência com expoente igual a ind, que resulta em rad.
@@ -113,7 +227,284 @@ int indOfRoot(int rad, double rt);
  * @param numTerms O número de termos que o polinômio deve conter.
  * @return Uma estrutura de polinômio com espaço alocado para o número especificado de termos.
  */
-polynomial pCreate(int numTerms);
+polynomial pCreate(int numTerms);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Retorna uma cópia densa de um polinômio, com um termo para cada expoente.
+ *
+ * A cópia tem termos do maior expoente até 0, em ordem decrescente, com
+ * coeficientes zero preenchendo os expoentes ausentes. Expoentes repetidos são
+ * somados. Entradas esparsas como x^5 - x + 1 viram 1, 0, 0, 0, -1, 1.
+ *
+ * @param p O polinômio (não modificado).
+ * @return Um novo polinômio denso (seus termos e coeficientes no heap devem ser
+ *         liberados por quem chama).
+ */
+polynomial pDense(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calcula o máximo divisor comum de dois polinômios sobre os inteiros.
+ *
+ * O resultado é mdc(conteúdo(a), conteúdo(b)) vezes o mdc primitivo, com coeficiente
+ * líder positivo. O mdc primitivo é calculado por:
+ * 1. MDC heurístico (GCDHEU) para grau até GCDHEU_MAX_DEGREE: avalia os dois
+ *    polinômios em um inteiro ξ, calcula o mdc dos inteiros e lê os dígitos na base
+ *    ξ como candidato, aceito apenas se dividir os dois polinômios;
+ * 2. MDC modular: mdc módulo primos de 31 bits, combinados pelo Teorema Chinês do
+ *    Resto até o candidato dividir os dois polinômios;
+ * 3. Sequência de restos primitiva, apenas se os dois métodos acima estourarem;
+ * 4. MDC modular com coeficientes de vários limbs, se a sequência de restos também
+ *    estourar ou uma entrada tiver coeficientes no heap, então o resultado é sempre
+ *    exato; coeficientes fora do int ficam no heap.
+ *
+ * @param a O primeiro polinômio (não modificado).
+ * @param b O segundo polinômio (não modificado).
+ * @return Um novo polinômio denso com o mdc (seus termos devem ser liberados por quem chama).
+ */
+polynomial pGcd(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Retorna o n-ésimo polinômio ciclotômico Phi_n.
+ *
+ * Os coeficientes vêm de um cache global do processo, preenchido sob demanda e
+ * seguro para compartilhar entre threads. Cada entrada é construída uma única
+ * vez pelo produto de Möbius Phi_m(x) = prod_{d|m} (1 - x^d)^mu(m/d) sobre o
+ * núcleo ímpar livre de quadrados m de n, usando apenas atualizações esparsas,
+ * e depois esticada com Phi_2m(x) = Phi_m(-x) e Phi_n(x) = Phi_rad(n)(x^(n/rad(n))).
+ *
+ * @param n Ordem, 1 <= n < 4194304
+ * @return Um novo polinômio denso Phi_n, vazio se n estiver fora do intervalo (seus
+ *         termos devem ser liberados por quem chama).
+ */
+polynomial pCyclotomic(int n);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Isola as raízes reais de um polinômio em intervalos racionais disjuntos.
+ *
+ * Trabalha sobre a parte livre de quadrados de p com aritmética inteira exata
+ * (Vincent-Collins-Akritas com frações contínuas). As raízes positivas são
+ * encontradas acompanhando uma transformação de Möbius M(x) = (ax + b)/(cx + d) e o
+ * polinômio cujas raízes positivas são as pré-imagens das raízes em (M(0), M(inf)):
+ * 1. Se o polinômio não tem variação de sinal, o ramo não tem raízes; com uma,
+ *    (M(0), M(inf)) isola exatamente uma raiz (regra de sinais de Descartes)
+ * 2. Senão, salta para uma cota inferior b de suas raízes positivas, x -> x + b,
+ *    escalando antes x -> bx quando b > 16 (o quociente parcial da fração contínua)
+ * 3. Divide em (1, inf) por x -> x + 1 e (0, 1) por x -> 1/(x + 1)
+ *
+ * Os coeficientes são mantidos como inteiros de vários limbs, então nunca estouram;
+ * um termo constante nulo registra M(0) como raiz exata. As raízes negativas vêm de
+ * p(-x), e o intervalo ilimitado da maior raiz é fechado pela cota de Cauchy, ou
+ * pela de Fujiwara quando a de Cauchy não cabe em um long long. A parte livre de
+ * quadrados é calculada com coeficientes de uma palavra quando cabem, e com
+ * vários limbs para coeficientes no heap.
+ *
+ * @param p O polinômio (não é modificado).
+ * @param numRoots Recebe o número de raízes reais distintas, ou -1 se uma ponta
+ *                 de intervalo ou a cota das raízes não couber em um long long.
+ * @return Um novo vetor de intervalos ordenados pela ponta esquerda (deve ser
+ *         liberado por quem chama), ou NULL se não houver raízes reais ou em falha.
+ */
+rootInterval* pRealRoots(polynomial p, int* numRoots);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Estreita um intervalo isolante de pRealRoots() por bissecção exata.
+ *
+ * O sinal da parte livre de quadrados de p em cada ponto médio u/v é calculado
+ * exatamente como v^n p(u/v). Um ponto médio que seja raiz reduz o intervalo a ele.
+ *
+ * @param p O mesmo polinômio passado a pRealRoots() (não é modificado).
+ * @param r O intervalo a refinar (modificado no lugar).
+ * @param width A largura desejada.
+ * @return 1 se o intervalo tiver no máximo width de largura, 0 se as pontas
+ *         deixarem de caber em um long long antes disso.
+ */
+int pRefineRoot(polynomial p, rootInterval* r, double width);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calcula o deslocamento de Taylor p(x + a).
+ *
+ * Usa o esquema clássico de Horner, com um caminho só de somas para a = 1, em
+ * O(n^2) operações nos coeficientes. Os coeficientes são inteiros de vários limbs
+ * o tempo todo, e os do resultado que não cabem em um int são devolvidos em
+ * term.big.
+ *
+ * @param p O polinômio (não é modificado).
+ * @param a O deslocamento.
+ * @return Um novo polinômio denso (seus termos e coeficientes no heap devem ser
+ *         liberados por quem chama).
+ */
+polynomial pTaylorShift(polynomial p, int a);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Multiplica dois polinômios.
+ *
+ * O método depende do operando mais curto: escolar abaixo de MUL_KARATSUBA_TERMS
+ * coeficientes, Karatsuba abaixo de MUL_NTT_TERMS e, acima disso, transformadas
+ * teórico-numéricas módulo dois primos menores que 2^62, unidas pelo teorema
+ * chinês do resto. Dois primos cobrem todo produto de coeficientes int. Operandos
+ * com coeficientes no heap são multiplicados por substituição de Kronecker.
+ *
+ * @param a O primeiro fator (não é modificado).
+ * @param b O segundo fator (não é modificado).
+ * @return Um novo polinômio denso (seus termos e coeficientes no heap devem ser
+ *         liberados por quem chama), ou um polinômio vazio se algum fator for vazio.
+ */
+polynomial pMul(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Eleva um polinômio a uma potência por quadrados sucessivos com pMul().
+ *
+ * @param p A base (não é modificada).
+ * @param e O expoente; p^0 é a constante 1.
+ * @return Um novo polinômio denso (seus termos e coeficientes no heap devem ser
+ *         liberados por quem chama), ou um polinômio vazio se e < 0 ou p for vazio.
+ */
+polynomial pPow(polynomial p, int e);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Multiplica dois polinômios esparsos com o heap de Monagan-Pearce.
+ *
+ * Os termos de cada fator são ordenados e somados; um heap com uma entrada por
+ * termo do fator mais curto produz os produtos em ordem decrescente de expoente.
+ * Entradas de mesmo expoente ficam encadeadas em um único nó do heap. A memória
+ * fica proporcional aos fatores mais o resultado. Quando o produto das contagens
+ * de termos alcança SPARSE_MUL_DENSITY vezes o grau do resultado, usa-se pMul().
+ *
+ * @param a O primeiro fator (não é modificado; termos podem vir fora de ordem ou repetidos).
+ * @param b O segundo fator (não é modificado; termos podem vir fora de ordem ou repetidos).
+ * @return Um novo polinômio só com termos não nulos em ordem decrescente de expoente
+ *         (seus termos e coeficientes no heap devem ser liberados por quem chama).
+ *         É vazio se o produto for zero ou seu grau passar de INT_MAX.
+ */
+polynomial pMulSparse(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Divide a por b com resto, de forma exata sobre os racionais.
+ *
+ * O quociente é devolvido como q / d com q inteiro, de modo que d a = b q + r e
+ * grau r < grau b. d é o menor denominador comum positivo. Vale 1 quando o
+ * coeficiente líder de b é 1 ou -1 e, nos demais casos, divide uma potência dele.
+ * Divisores ou quocientes pequenos usam a pseudodivisão clássica. Quando ambos têm
+ * ao menos DIVREM_NEWTON_TERMS coeficientes e o coeficiente líder de b é 1 ou -1,
+ * o quociente é calculado módulo primos de uma palavra com recíproco por iteração
+ * de Newton e produtos por NTT. Os resíduos são unidos pelo TCR até pararem de
+ * mudar, e o resultado é conferido com um único produto exato.
+ *
+ * @param a O dividendo (não é modificado).
+ * @param b O divisor (não é modificado).
+ * @param q Recebe o numerador denso do quociente (vazio se grau a < grau b).
+ * @param r Recebe o numerador do resto (vazio se b divide a).
+ * @return O denominador d como termo de expoente 0, ou um termo nulo, com q e r
+ *         vazios, se b for zero. Os termos e coeficientes no heap de q e r, e o
+ *         coeficiente no heap de d, devem ser liberados por quem chama.
+ */
+term pDivRem(polynomial a, polynomial b, polynomial* q, polynomial* r);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Monta a árvore de subprodutos de um conjunto de pontos, para reuso em pEvalMulti() e pInterpolate().
+ *
+ * Os produtos dos nós são calculados pela primeira chamada que precisa deles.
+ *
+ * @param points Os pontos (copiados).
+ * @param numPoints Número de pontos.
+ * @return A árvore, a ser liberada com pTreeFree().
+ */
+subproductTree pTreeCreate(const int* points, int numPoints);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Avalia um polinômio em todos os pontos de uma árvore de subprodutos.
+ *
+ * p é reduzido módulo o produto da raiz, e cada resto é então reduzido módulo os
+ * dois filhos. Os restos que chegam às folhas são avaliados diretamente. Isso é
+ * feito módulo primos de uma palavra suficientes para limitar os valores, que são
+ * recuperados por CRT. Cada primo custa O(M(n) log n) para n pontos.
+ *
+ * @param p O polinômio (não é modificado).
+ * @param tree Árvore de pTreeCreate() (produtos de nós podem ser acrescentados a ela).
+ * @return Vetor com p(x_i) como termos de expoente 0, na ordem dos pontos
+ *         (o vetor e seus coeficientes no heap devem ser liberados por quem chama).
+ */
+term* pEvalMulti(polynomial p, subproductTree* tree);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Encontra o polinômio de grau menor que n que assume os valores dados nos n pontos da árvore.
+ *
+ * O resultado é a soma de v_i / M'(x_i) M(x) / (x - x_i), onde M é o produto da
+ * raiz. As subárvores se combinam como esq M_dir + dir M_esq. Os pesos
+ * D / M'(x_i), com D o mmc dos M'(x_i), dependem só dos pontos. São calculados
+ * uma vez e guardados na árvore. O numerador é recuperado por CRT de primos de
+ * uma palavra.
+ *
+ * @param tree Árvore de pTreeCreate() (seus pesos são preenchidos na primeira chamada).
+ * @param values Os valores nos pontos, um por ponto.
+ * @param f Recebe o numerador do polinômio interpolador.
+ * @return O menor denominador positivo d, tal que f / d é o polinômio interpolador,
+ *         como termo de expoente 0. É um termo nulo, com f vazio, se dois pontos
+ *         coincidirem. Os termos de f e todos os coeficientes no heap devem ser
+ *         liberados por quem chama.
+ */
+term pInterpolate(subproductTree* tree, const term* values, polynomial* f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calcula a resultante de dois polinômios.
+ *
+ * A resultante é encontrada módulo primos de uma palavra pelo algoritmo de
+ * Euclides, acompanhando os coeficientes líderes, e juntada por CRT. A busca para
+ * assim que um novo primo não altera o valor, ou quando os primos cobrem a cota de
+ * Hadamard. Uma parada antecipada só erra se o valor verdadeiro e o parcial
+ * coincidirem módulo um primo de 61 bits.
+ *
+ * @param a O primeiro polinômio (não é modificado).
+ * @param b O segundo polinômio (não é modificado).
+ * @return res(a, b) como termo de expoente 0 (seu coeficiente no heap deve ser
+ *         liberado por quem chama). É zero se a ou b for zero, ou se tiverem uma
+ *         raiz em comum.
+ */
+term pResultant(polynomial a, polynomial b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calcula o discriminante de um polinômio.
+ *
+ * Para p de grau n com coeficiente líder c, é (-1)^(n(n - 1)/2) res(p, p') / c,
+ * calculado como em pResultant(). É zero exatamente quando p tem uma raiz
+ * repetida, e é assim que fac() decide se uma entrada com coeficientes no heap
+ * precisa ser separada em partes livres de quadrados antes de aberth().
+ *
+ * @param p O polinômio (não é modificado).
+ * @return O discriminante como termo de expoente 0 (seu coeficiente no heap deve
+ *         ser liberado por quem chama), ou um termo nulo se p for constante.
+ */
+term pDiscriminant(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Cria um polinômio racional com o número de termos dado.
+ *
+ * Os termos são definidos como em pCreate(), por q.num.terms[i] = setTerms(a, exp)
+ * ou setBigTerms(), e os denominadores por q.den[i], que começam em 1.
+ *
+ * @param numTerms Número de termos.
+ * @return O polinômio, a ser liberado com qFree().
+ */
+qPolynomial qCreate(int numTerms);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Separa um polinômio racional em conteúdo e parte primitiva inteira, no próprio lugar.
+ *
+ * Uma única varredura reduz cada a_i / b_i e reúne o mdc dos numeradores e o mmc
+ * dos denominadores, cujo quociente é o conteúdo. Os termos de q->num são então
+ * reescritos como a parte primitiva, com coeficiente líder positivo, e todos os
+ * denominadores passam a 1. Nenhuma cópia é feita, então q->num fica pronto para
+ * as funções inteiras. Como em divideGCD(), o mdc é encontrado em aritmética de
+ * 64 bits e é 1 se todo numerador for pelo menos 2^64.
+ *
+ * @param q O polinômio (modificado no próprio lugar).
+ * @param den Recebe o denominador do conteúdo, o mmc dos denominadores reduzidos.
+ * @return O numerador do conteúdo, com o sinal do coeficiente líder, tal que
+ *         q = (retorno / den) q->num. É um termo nulo, com den igual a 1, se todos
+ *         os numeradores forem zero. Os coeficientes no heap dos dois termos devem
+ *         ser liberados por quem chama.
+ */
+term qPrimitive(qPolynomial* q, term* den);
 //-----------------------------------------------------------------------------
 /**
  * @brief Imprime o polinômio.
@@ -129,13 +520,51 @@ void pPrint(polynomial p);
  * @param b O segundo inteiro.
  * @return O máximo divisor comum de a e b.
  */
-int gcd(int a, int b);
+int gcd(int a, int b);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Lista os divisores positivos de um inteiro em ordem crescente.
+ *
+ * Os divisores são montados a partir da fatoração em primos dada por factorInt().
+ * As últimas DIVISORS_CACHE_SIZE listas ficam em uma cache de uso mais recente
+ * indexada por |n|, então termos constantes e coeficientes líderes repetidos não
+ * são fatorados de novo. A cache é protegida por uma trava de espera ativa, então
+ * a função pode ser chamada de várias threads.
+ *
+ * @param n O inteiro (seu sinal é ignorado e ele não pode ser 0). Para INT_MIN o
+ *          divisor 2^31, que não cabe em um int, fica de fora.
+ * @param count Saída: número de divisores encontrados.
+ * @return Vetor dinâmico com os divisores (deve ser liberado por quem chama).
+ */
+int* divisors(int n, int* count);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Fatora um inteiro em primos.
+ *
+ * Usa divisão por tentativa com uma roda 2·3·5 até FACTOR_WHEEL_LIMIT e depois
+ * quebra o cofator restante com o rho de Pollard (variante de Brent), verificando
+ * cada parte com isPrime().
+ *
+ * @param n O inteiro (seu sinal é ignorado).
+ * @param primes Saída: fatores primos distintos em ordem crescente (espaço para 16).
+ * @param mult Saída: multiplicidade de cada fator primo (espaço para 16).
+ * @return Número de fatores primos distintos (0 para n = 0 ou n = ±1).
+ */
+int factorInt(long long n, unsigned long long* primes, int* mult);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Teste de primalidade de Miller-Rabin determinístico para inteiros de 64 bits.
+ *
+ * @param n O inteiro a ser testado.
+ * @return 1 se n for primo, 0 caso contrário.
+ */
+int isPrime(unsigned long long n);
 //-----------------------------------------------------------------------------
 /**
  * @brief Gera uma representação em string da forma fatorada para uma equação
  *        quadrática com raízes inteiras (racionais) e discriminante positivo.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4, indicando fatores lineares ou quadráticos)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -144,13 +573,13 @@ int gcd(int a, int b);
  * @param powerRoot String indicando o formato do expoente da raiz ("^2" para quartico, vazio para quadrático)
  * @return Ponteiro para o buffer de string formatado
  */
-char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* intSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Gera uma representação em string da forma fatorada para uma equação
  *        quadrática com raízes inteiras (racionais) e discriminante negativo.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4, indicando fatores lineares ou quadráticos)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -159,13 +588,27 @@ char* intSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, c
  * @param powerRoot String indicando o formato do expoente da raiz ("^2" para quartico, vazio para quadrático)
  * @return Ponteiro para o buffer de string formatado
  */
-char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
-//-----------------------------------------------------------------------------
+char* intSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Reduz o radical (b ± Sqrt[radicand]) / den aos menores termos.
+ *
+ * Os fatores quadrados do radicando são extraídos com factorInt(), de modo que
+ * radicand = s^2 r com r livre de quadrados, e o fator comum de b, s e den é
+ * cancelado, por exemplo Sqrt[20]/2 vira Sqrt[5].
+ *
+ * @param b A parte racional (modificada no próprio lugar).
+ * @param den O denominador (modificado no próprio lugar).
+ * @param radicand O radicando positivo, trocado por sua parte livre de quadrados r.
+ * @return O coeficiente de Sqrt[r] depois do cancelamento.
+ */
+long long surdReduce(long long* b, long long* den, long long* radicand);
+//-----------------------------------------------------------------------------
 /**
  * @brief Gera uma representação em string da forma fatorada para uma equação
  *        quadrática com raízes irracionais e discriminante positivo.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4, indicando fatores lineares ou quadráticos)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -174,13 +617,13 @@ char* intSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, c
  * @param powerRoot String indicando o formato do expoente da raiz ("^2" para quartico, vazio para quadrático)
  * @return Ponteiro para o buffer de string formatado
  */
-char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* floatSrPositiveDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Gera uma representação em string da forma fatorada para uma equação
  *        quadrática com raízes complexas irracionais e discriminante negativo.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4, indicando fatores lineares ou quadráticos)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -189,13 +632,13 @@ char* floatSrPositiveDelta(int aexp, int den, int b, double delta, int absDelta,
  * @param powerRoot String indicando o formato do expoente da raiz ("^2" para quartico, vazio para quadrático)
  * @return Ponteiro para o buffer de string formatado
  */
-char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* floatSrNegativeDelta(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Determina a função de formatação apropriada para raízes racionais
  *        com base no sinal do discriminante.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -204,13 +647,13 @@ char* floatSrNegativeDelta(int aexp, int den, int b, double delta, int absDelta,
  * @param powerRoot String indicando o formato do expoente da raiz
  * @return Ponteiro para o buffer de string formatado
  */
-char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* rationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Determina a função de formatação apropriada para raízes irracionais
  *        com base no sinal do discriminante.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -219,7 +662,7 @@ char* rationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char
  * @param powerRoot String indicando o formato do expoente da raiz
  * @return Ponteiro para o buffer de string formatado
  */
-char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, char* bSimplify, char* powerRoot);
+char* irrationalSqRoots(int aexp, long long den, long long b, double delta, long long absDelta, char* bSimplify, char* powerRoot);
 //-----------------------------------------------------------------------------
 /**
  * @brief Função principal de simplificação que coordena a formatação de raízes
@@ -229,7 +672,7 @@ char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, ch
  * se as raízes são racionais ou irracionais, então chama as funções de formatação
  * apropriadas.
  *
- * @param aexp O expoente do primeiro termo (2 ou 4)
+ * @param aexp O expoente do primeiro termo (2, ou 2k para fatores em x^k)
  * @param den O valor do denominador (2a) da fórmula de Bhaskara
  * @param b O coeficiente b da equação quadrática
  * @param delta O valor do discriminante (b² - 4ac)
@@ -237,7 +680,7 @@ char* irrationalSqRoots(int aexp, int den, int b, double delta, int absDelta, ch
  * @param rootsPair Vetor contendo as duas raízes calculadas
  * @return Ponteiro para o buffer de string formatado (deve ser liberado pelo chamador)
  */
-char* bhaskaraSimplify(int aexp, int den, int b, double delta, int absDelta, double* rootsPair);
+char* bhaskaraSimplify(int aexp, long long den, long long b, double delta, long long absDelta, double* rootsPair);
 //-----------------------------------------------------------------------------
 /**
  * @brief Calcula e imprime a fatoração de um polinômio de segundo grau
@@ -253,17 +696,45 @@ void bhaskara(polynomial p);
 /**
  * @brief Fatora um polinômio usando o Teorema das Raízes Racionais e divisão sintética.
  *
- * Aplica o método de Briot-Ruffini para encontrar raízes inteiras no intervalo
- * [-√maxNum, √maxNum]. Quando um fator quadrático é encontrado, chama bhaskara()
- * para completar a fatoração (incluindo raízes complexas).
- *
- * @param p Polinômio a ser fatorado (modificado durante o processo)
- * @param maxNum Maior valor absoluto dos coeficientes do polinômio original
- *
- * @note O polinômio de entrada é reduzido à medida que raízes são encontradas.
- * @note A variável global sol indica se a fatoração foi completa.
- */
-void briotRuffini(polynomial p, int maxNum);
+ * Testa todas as raízes candidatas ±r/s, onde r divide o termo constante e s divide
+ * o coeficiente líder, e reduz o polinômio por cada raiz encontrada (raízes repetidas
+ * são removidas quantas vezes ocorrerem). As raízes são impressas como (x - r) ou
+ * (sx - r). O resto, que não tem raízes racionais, é separado em fatores
+ * irredutíveis por zassenhaus() e cada fator é impresso por irreducibleFac(). Um
+ * resto acima de ZASSENHAUS_MAX_DEGREE vai direto para aberth().
+ *
+ * Com coeficientes no heap (veja pHasBig()) as candidatas são testadas de forma
+ * exata em inteiros de vários limbs, desde que o coeficiente líder e o termo
+ * constante caibam em um long long e deem no máximo BIG_ROOT_CANDIDATES pares. Um
+ * resto linear é impresso de forma exata qualquer que seja seu tamanho. Um resto
+ * maior volta ao caminho de int se a redução o trouxe para essa faixa, e vai para
+ * aberth() caso contrário.
+ *
+ * @param p Polinômio denso a ser fatorado (veja pDense()), com termo constante
+ *          não nulo. Seus termos são modificados durante o processo.
+ * @param maxNum Não utilizado. As candidatas agora vêm dos divisores do coeficiente
+ *               líder e do termo constante; o parâmetro é mantido para que chamadas
+ *               existentes continuem compilando.
+ *
+ * @note O polinômio de entrada é reduzido à medida que raízes são encontradas.
+ * @note A variável global sol indica se a fatoração foi completa.
+ */
+void briotRuffini(polynomial p, int maxNum);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Imprime a fatoração de um polinômio irredutível sobre os inteiros.
+ *
+ * Fatores lineares são impressos como (sx - r), binômios ax^n + b por
+ * binomialFac() para saírem iguais a quando fac() os recebe inteiros, quadráticos
+ * na forma fechada por bhaskara(), ciclotômicos de grau maior como raízes da unidade exatas por
+ * printCyclotomicRoots(), trinômios ax^2k + bx^k + c por bhaskara() como fatores em
+ * x^k, cúbicos por cardano(), quárticos por ferrari(), e os demais são aproximados
+ * por aberth(). Só os fatores (x - r) são impressos, sem parênteses em volta do
+ * grupo, de modo que quem o eleva a uma potência acrescenta o único par necessário.
+ *
+ * @param p Polinômio denso irredutível (veja pDense()).
+ */
+void irreducibleFac(polynomial p);
 //-----------------------------------------------------------------------------
 /**
  * @brief Função principal de fatoração que coordena todas as estratégias.
@@ -271,10 +742,22 @@ void briotRuffini(polynomial p, int maxNum);
  * Orquestra o processo completo de fatoração na seguinte ordem:
  * 1. Extrai fator x (se houver) via divideX() [recursivo]
  * 2. Extrai MDC dos coeficientes via divideGCD()
- * 3. Se for quadrático/biquadrático: usa bhaskara()
- * 4. Se os coeficientes forem sequenciais: usa briotRuffini()
- * 5. Se os coeficientes forem ±1: usa cyclotomicFac()
- * 6. Caso contrário: usa aberth() para aproximação numérica
+ * 3. Se algum coeficiente estiver no heap: separa-o com squareFree() e envia cada
+ *    parte para briotRuffini(), que encontra as raízes racionais de forma exata;
+ *    partes com multiplicidade m > 1 são impressas como (...)^m
+ * 4. Senão, se restarem apenas dois termos, ax^n + b: usa binomialFac()
+ * 5. Senão, se todos os coeficientes estiverem em {-1, 0, 1} ou se for um produto de
+ *    polinômios ciclotômicos (veja isCyclotomicProduct()): usa cyclotomicFac()
+ * 6. Caso contrário: separa o polinômio em partes livres de quadrados com
+ *    squareFree(). Partes que dividem algum x^N - 1 (veja findN()) são impressas
+ *    de forma exata por printCyclotomicRoots(); as demais são enviadas uma única
+ *    vez para briotRuffini(), que remove todas as raízes racionais e fatora o
+ *    resto sobre os inteiros com zassenhaus(). Cada fator irredutível vai para
+ *    irreducibleFac(), que usa bhaskara(), printCyclotomicRoots() ou aberth()
+ *    para aproximação numérica. Um resto acima de ZASSENHAUS_MAX_DEGREE pula
+ *    zassenhaus() e vai para aberth(), que resolve entradas esparsas pelo
+ *    polígono de Newton em vez da iteração simples. Partes com multiplicidade m > 1 são
+ *    impressas como (...)^m, então aberth() só recebe raízes simples
  *
  * @param p Polinômio a ser fatorado
  *
@@ -292,7 +775,7 @@ void printFac(polynomial p);
 //-----------------------------------------------------------------------------
 /**
  * @brief Diferente de `printFac()`, esta alternativa também desaloca a memória dos termos
- * do polinômio usando `free(p.terms)`.
+ * do polinômio usando `free(p.terms)`, junto com os coeficientes no heap.
  *
  * @param p O polinômio a ser fatorado.
  */
@@ -320,9 +803,139 @@ void divideX(polynomial p);
  *
  * @param p Polinômio a ser simplificado (modificado in-place)
  *
- * @note A variável global divider armazena o MDC extraído
+ * @note A variável global divider armazena o MDC extraído, com sinal escolhido
+ *       para que o coeficiente líder fique positivo
+ * @note Se o MDC não puder ser achado em aritmética de 64 bits, o que exige todos
+ *       os coeficientes de pelo menos 2^63, divider é ±1 e p não é alterado
  */
-void divideGCD(polynomial p);
+void divideGCD(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Calcula a decomposição livre de quadrados de um polinômio sobre os inteiros.
+ *
+ * Usa o algoritmo de Yun na parte primitiva de p: p = parts[0] · parts[1]^2 · ... ·
+ * parts[k-1]^k, onde as partes são livres de quadrados, coprimas duas a duas,
+ * primitivas e têm coeficiente líder positivo. Partes sem raízes são a constante 1.
+ * Se p tiver coeficientes no heap, ou algum coeficiente intermediário estourar, o
+ * mesmo algoritmo roda com coeficientes de vários limbs, e as partes podem ter
+ * termos no heap.
+ *
+ * @param p Polinômio com coeficientes inteiros (não modificado).
+ * @param numParts Saída: número de partes (k).
+ * @return Vetor dinâmico de polinômios densos; parts[i] tem multiplicidade i + 1 (os
+ *         termos de cada parte e o próprio vetor devem ser liberados por quem chama).
+ */
+polynomial* squareFree(polynomial p, int* numParts);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Fatora um polinômio livre de quadrados em fatores irredutíveis sobre os inteiros.
+ *
+ * Algoritmo de Zassenhaus:
+ * 1. Testa até ZASSENHAUS_PRIMES primos ímpares p que mantêm o grau e a propriedade
+ *    de ser livre de quadrados, e fica com o que dá menos fatores módulo p;
+ * 2. Fatora p módulo p por fatoração de graus distintos e separação de grau igual
+ *    de Cantor-Zassenhaus;
+ * 3. Levanta os fatores modulares até p^k com o levantamento de Hensel para vários
+ *    fatores, onde p^k passa do dobro da cota de Landau-Mignotte vezes o
+ *    coeficiente líder, ou a maior potência abaixo de 2^62 quando a cota não cabe;
+ * 4. Com mais de VANHOEIJ_THRESHOLD fatores levantados, recombina-os com a mochila
+ *    de van Hoeij: as somas de potências das raízes de cada fator entram num
+ *    reticulado uma coluna por vez e são reduzidas com LLL até que os vetores
+ *    curtos descrevam uma partição cujos produtos dividem p;
+ * 5. Caso contrário, recombina subconjuntos dos fatores levantados, dos menores
+ *    para os maiores, descartando cedo um subconjunto cujo termo constante não
+ *    divide lc·p(0), e guarda cada candidato que divide p exatamente.
+ *
+ * Todo fator é conferido por divisão exata. Quando a cota não cabe em 62 bits ou
+ * o reticulado não se estabiliza, o que sobrar é devolvido como um único fator. Um
+ * p com coeficientes no heap não é fatorado, pois sua cota de Landau-Mignotte passa
+ * de 62 bits, e nem um acima de ZASSENHAUS_MAX_DEGREE (256), pois só a etapa de
+ * graus distintos já é cúbica no grau para cada primo testado.
+ *
+ * @param p Polinômio livre de quadrados com coeficientes inteiros (não modificado).
+ * @param numFactors Saída: número de fatores, ou -1 se p não é fatorado.
+ * @return Vetor dinâmico de fatores densos primitivos com coeficiente líder positivo
+ *         (os termos de cada fator e o próprio vetor devem ser liberados por quem
+ *         chama), ou NULL se p não é fatorado.
+ */
+polynomial* zassenhaus(polynomial p, int* numFactors);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Cria um polinômio nulo sobre GF(p).
+ *
+ * @param degree Grau do polinômio; são alocados degree + 1 coeficientes.
+ * @param p Módulo primo, menor que 2^62.
+ * @return Um gfPolynomial com todos os coeficientes iguais a zero.
+ */
+gfPolynomial gfCreate(int degree, unsigned long long p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Reduz um polinômio com coeficientes inteiros módulo um primo.
+ *
+ * @param p Polinômio com coeficientes inteiros (não modificado).
+ * @param prime Módulo primo, menor que 2^62.
+ * @return A imagem de p em GF(prime)[x], com o grau ajustado.
+ */
+gfPolynomial gfFromPoly(polynomial p, unsigned long long prime);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Libera os coeficientes de um polinômio sobre GF(p).
+ *
+ * @param f Polinômio a ser liberado.
+ */
+void gfFree(gfPolynomial f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Libera os produtos dos nós, os pesos e os pontos de uma árvore de subprodutos.
+ *
+ * @param t Árvore a ser liberada.
+ */
+void pTreeFree(subproductTree t);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Libera os termos, os coeficientes no heap e os denominadores de um polinômio racional.
+ *
+ * @param q Polinômio a ser liberado.
+ */
+void qFree(qPolynomial q);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Imprime um polinômio sobre GF(p), sem os termos nulos, seguido do seu módulo.
+ *
+ * @param f Polinômio a ser impresso.
+ */
+void gfPrint(gfPolynomial f);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Fatora um polinômio em fatores mônicos irredutíveis sobre GF(p).
+ *
+ * O polinômio é tornado mônico e separado em partes livres de quadrados (extraindo
+ * raízes p-ésimas quando a derivada se anula). Cada parte passa pela fatoração de
+ * graus distintos e pela separação de grau igual de Cantor-Zassenhaus. Os produtos
+ * no corpo usam a redução de Montgomery, e x^p mod f é calculado por exponenciação
+ * com janela deslizante, então primos de até 2^62 custam só cerca de 62 quadrados
+ * modulares por passo de Frobenius.
+ *
+ * @param f Polinômio sobre GF(p) (não modificado).
+ * @param numFactors Saída: número de fatores, contados com multiplicidade.
+ * @return Vetor dinâmico de fatores ordenados por grau; um fator de multiplicidade
+ *         m aparece m vezes. O coeficiente líder de f não é devolvido (os
+ *         coeficientes de cada fator e o próprio vetor devem ser liberados por quem
+ *         chama).
+ */
+gfPolynomial* gfFactor(gfPolynomial f, int* numFactors);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Encontra as raízes distintas de um polinômio em GF(p).
+ *
+ * Calcula mdc(f, x^p - x), o produto dos fatores lineares distintos de f, e o
+ * separa com Cantor-Zassenhaus.
+ *
+ * @param f Polinômio sobre GF(p) (não modificado).
+ * @param numRoots Saída: número de raízes distintas.
+ * @return Vetor dinâmico de raízes em ordem crescente (deve ser liberado por quem chama).
+ */
+unsigned long long* gfRoots(gfPolynomial f, int* numRoots);
 //-----------------------------------------------------------------------------
 /**
  * @brief Remove termos com coeficiente zero do polinômio e realoca memória.
@@ -336,31 +949,179 @@ void divideGCD(polynomial p);
 void removeZeros(polynomial *p);
 //-----------------------------------------------------------------------------
 /**
- * @brief Fatora polinômios ciclotômicos (coeficientes ±1).
- *
- * Para polinômios da forma x^n + x^(n-1) + ... + x + 1 (ou variações com ±1),
- * encontra as raízes complexas no círculo unitário: exp(2πik/n).
- * Imprime os fatores lineares complexos usando notação exponencial.
- *
- * @param p Polinômio ciclotômico a ser fatorado
- *
- * @note Assume que o polinômio tem coeficientes apenas ±1
- * @note Imprime fatores no formato (x - Exp[i*π/m])
- */
-void cyclotomicFac(polynomial p);
-//-----------------------------------------------------------------------------
-/**
+ * @brief Fatora produtos de polinômios ciclotômicos e polinômios com coeficientes ±1.
+ *
+ * Remove por divisão exata cada Phi_d do cache (veja pCyclotomic()) que divide p,
+ * com sua multiplicidade, testando apenas as ordens d em que p se anula em uma
+ * raiz d-ésima primitiva da unidade módulo um primo. Os fatores lineares
+ * complexos são impressos em notação exponencial, agrupando os repetidos como (...)^m.
+ *
+ * O que sobra após os fatores ciclotômicos é separado com squareFree() e cada
+ * parte é resolvida diretamente por irreducibleFac(). Polinômios com coeficientes
+ * em {-1, 0, 1} raramente têm outros fatores sobre os inteiros, então
+ * zassenhaus() não é usado para eles.
+ *
+ * @param p Produto de polinômios ciclotômicos (veja isCyclotomicProduct()) ou
+ *          polinômio com coeficientes em {-1, 0, 1}
+ *
+ * @note Imprime fatores no formato (x - Exp[i*π/m])
+ */
+void cyclotomicFac(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Imprime as n raízes de um binômio ax^n + b em forma fechada.
+ *
+ * As raízes de x^n = -b/a são r * Exp[i*t*Pi/n], com t par quando -b/a > 0 e
+ * ímpar quando -b/a < 0, onde r é a raiz n-ésima real de |b/a|. É extraído o
+ * maior k que divide n para o qual |b| e |a| são potências k-ésimas exatas de
+ * inteiros, verificadas por multiplicação inteira com detecção de estouro,
+ * então r é impresso como inteiro ou fração, s Sqrt[r]/d reduzido ou Surd[..., n/k]. As
+ * raízes são geradas em ordem crescente de ângulo sem armazená-las, então n
+ * pode estar na casa dos milhões; para b/a = ±1 os fatores Exp[] são iguais aos de
+ * cyclotomicFac(). Raízes reais são impressas como ±r e o par de ângulo ±Pi/2
+ * como ±ri, então x^2 + 4 resulta em (x - 2i)(x + 2i).
+ *
+ * @param p Polinômio com exatamente dois termos não nulos, um deles constante,
+ *          após divideGCD()
+ *
+ * @note Imprime os demais fatores no formato (x - r*Exp[i*π/m])
+ */
+void binomialFac(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Encontra o menor N tal que p divide x^N - 1.
+ *
+ * p divide algum x^N - 1 exatamente quando é um produto de polinômios
+ * ciclotômicos Phi_d distintos, e o menor N é o mmc dessas ordens d.
+ * Como phi(d) >= sqrt(d/2), só podem aparecer ordens com d <= 2n^2 e
+ * phi(d) <= n, onde n é o grau de p.
+ *
+ * Algoritmo:
+ * 1. Rejeita p se isCyclotomicProduct() não o aceitar
+ * 2. Percorre as ordens candidatas d em ordem crescente. Phi_d só pode dividir p
+ *    se p se anula em uma raiz d-ésima primitiva da unidade módulo um primo
+ *    q = 1 (mod d), e cada candidata é confirmada por divisão exata pelo Phi_d do cache
+ * 3. Se cada ordem divide p uma única vez e a soma dos totientes for n, N é o mmc delas
+ *
+ * @param p Polinômio livre de quadrados com coeficientes inteiros
+ * @return O menor N, ou 0 se p não for produto de polinômios ciclotômicos
+ *         (sempre para p com coeficientes no heap)
+ */
+int findN(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Testa se p é um produto de polinômios ciclotômicos.
+ *
+ * Pelo teorema de Kronecker isso vale exatamente quando p é mônico a menos de
+ * sinal, p(0) != 0 e todas as raízes estão no círculo unitário. O passo de Graeffe
+ * g(x^2) = ±p(x)p(-x) eleva cada raiz ao quadrado, o que leva Phi_2m a uma potência
+ * de Phi_m e fixa Phi_m para m ímpar, então a sequência de iterados de Graeffe de um
+ * produto de ciclotômicos atinge um ponto fixo em até log2(2n^2) + 2 passos.
+ * Qualquer outro polinômio tem uma raiz fora do círculo unitário e nunca se fixa.
+ * A iteração é feita módulo 2^61 - 1, após testes rápidos de coeficientes
+ * extremos ±1 e de simetria (anti)palindrômica.
+ *
+ * @param p Polinômio com coeficientes inteiros (fatores repetidos permitidos)
+ * @return 1 se p for produto de polinômios ciclotômicos, 0 caso contrário; o teste usa
+ *         coeficientes de 64 bits, então é sempre 0 para p com coeficientes no heap
+ */
+int isCyclotomicProduct(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Verifica de forma exata, sobre os inteiros, se p divide x^N - 1.
+ *
+ * Calcula x^N mod p por potenciação binária. É exato porque p é mônico a menos
+ * de sinal, e a verificação falha com segurança se algum coeficiente estourar, o que
+ * inclui qualquer p com coeficientes no heap.
+ *
+ * @param p Polinômio com coeficientes inteiros
+ * @param N Expoente positivo
+ * @return 1 se p divide x^N - 1, 0 caso contrário
+ */
+int dividesXPowerNMinusOne(polynomial p, int N);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Imprime as raízes da unidade exatas de um divisor de x^N - 1.
+ *
+ * Imprime (x - 1) e (x + 1) para as ordens 1 e 2, e depois cada raiz restante
+ * como um par conjugado na mesma notação de cyclotomicFac().
+ *
+ * @param N Valor retornado por findN() para p
+ * @param p Polinômio que divide x^N - 1
+ */
+void printCyclotomicRoots(int N, polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Resolve uma cúbica irredutível em forma fechada (Cardano).
+ *
+ * Reduz ax^3 + bx^2 + cx + d a t^3 + pt + q e usa a fórmula de Cardano quando há
+ * uma raiz real, escolhendo o sinal da raiz quadrada que evita cancelamento, ou
+ * a forma trigonométrica 2sqrt(-p/3)cos(...) quando as três raízes são reais.
+ * Cada raiz é então refinada por dois passos de Newton.
+ *
+ * Se a variável global radicals estiver ativa, as raízes são impressas de forma
+ * exata, com CubeRoot[...] e Sqrt[...] para uma raiz real ou Cos[ArcCos[...]] para três.
+ *
+ * @param p Polinômio denso irredutível de grau 3
+ */
+void cardano(polynomial p);
+//-----------------------------------------------------------------------------
+/**
+ * @brief Resolve uma quártica irredutível em forma fechada (Ferrari).
+ *
+ * Reduz a quártica a y^4 + py^2 + qy + r, toma a maior raiz real m da cúbica
+ * resolvente 8m^3 + 8pm^2 + (2p^2 - 8r)m - q^2 (resolvida pelo mesmo método de
+ * cardano()) e a separa em duas quadráticas y^2 ∓ sqrt(2m)y + p/2 + m ± q/(2sqrt(2m)).
+ * Quando q = 0 é resolvida como quadrática em y^2. Cada raiz é então refinada por
+ * dois passos de Newton.
+ *
+ * @param p Polinômio denso irredutível de grau 4
+ */
+void ferrari(polynomial p);
+//-----------------------------------------------------------------------------
+/**
  * @brief Aproxima todas as raízes de um polinômio usando o método de Aberth.
  *
  * Implementa o método de Aberth (ou Aberth–Ehrlich) para aproximação simultânea
  * de todas as raízes (reais e complexas) de um polinômio.
  *
- * Algoritmo:
- * 1. Converte coeficientes para double
- * 2. Estima raio máximo das raízes: R = 1 + max|coef[i]/coef[0]|
- * 3. Inicializa raízes igualmente espaçadas no círculo de raio R
- * 4. Itera a correção de Aberth até convergência:
- *    z_k^(novo) = z_k - [P(z_k)/P'(z_k)] / [1 - (P(z_k)/P'(z_k)) * Σ_{j≠k} 1/(z_k - z_j)]
+ * Algoritmo:
+ * 1. Escreve p(x) = q(x^k), onde k é o mdc dos expoentes, e converte os
+ *    coeficientes de q para double
+ * 2. Se q for palindrômico de grau par 2m, resolve no lugar o polinômio de
+ *    grau m em y = x + 1/x, convertido de forma exata pelos polinômios de
+ *    Dickson x^k + x^-k = D_k(y) (ignorado se a conversão estourar), e leva
+ *    cada raiz y de volta por x^2 - yx + 1 = 0, refinando as duas raízes com
+ *    passos de Newton em q
+ * 3. Caso contrário, se q for um polinômio esparso (no máximo 8 termos não
+ *    nulos e grau pelo menos 32), toma o fecho convexo superior dos pontos
+ *    (e, log|c|) de seus termos: cada aresta de e_a a e_b contém e_b - e_a
+ *    raízes perto do círculo de raio (|c_a|/|c_b|)^(1/(e_b - e_a)), iniciadas
+ *    nas raízes do binômio da aresta. Cada raiz é refinada por passos de
+ *    Newton apenas sobre os termos esparsos, O(t) por passo, limitados a um
+ *    quarto do espaçamento entre as raízes de sua aresta; raízes que não
+ *    convergem ou coincidem com outra recebem correções de Aberth. Se ainda
+ *    assim falhar, segue abaixo
+ * 4. Caso contrário (e também para o polinômio em y), procura uma decomposição
+ *    funcional q = g(h(x)) com grau h = s, testando cada divisor s do grau
+ *    de q: h é normalizado mônico com h(0) = 0, seus
+ *    coeficientes do topo vêm da série de potências da raiz r-ésima de q no
+ *    infinito (r = grau q / s), e g de divisões sucessivas de q por h, aceita
+ *    só se todo resto for constante com precisão relativa de 1e-12. Uma
+ *    candidata aprovada é então confirmada de forma exata: a mesma construção
+ *    é refeita com bigInts sobre C^n q(x / C) / lc, primeiro com C = 1 e
+ *    depois com C = r^2 lc, para que h vire um polinômio inteiro, e ela só é
+ *    usada se todo resto sair exatamente constante. Se houver,
+ *    acha primeiro as raízes de g e depois, para cada raiz c, as raízes de
+ *    h(x) - c, ou seja, um problema de grau r e r de grau s em vez de um de
+ *    grau rs
+ * 5. Caso contrário, estima o raio das raízes pela cota de Fujiwara
+ *    R = 2 * max|coef[i]/coef[0]|^(1/i), inicializa as raízes igualmente
+ *    espaçadas no círculo de raio R e itera a correção de Aberth até
+ *    convergência:
+ *    z_k^(novo) = z_k - [P(z_k)/P'(z_k)] / [1 - (P(z_k)/P'(z_k)) * Σ_{j≠k} 1/(z_k - z_j)]
+ * 6. Expande cada raiz y de q nas k raízes nrt(|y|, k) * exp(i(arg y + 2πj)/k)
+ *    de p, então cada varredura custa cerca de k² vezes menos do que em p
  *
  * @param p Polinômio cujas raízes serão aproximadas
  *
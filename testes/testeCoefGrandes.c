@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "polynomialsz.h"
+
+int falhas = 0;
+
+void verifica(int ok, const char* nome) {
+
+    printf("%s - %s\n", ok ? "OK" : "FALHOU", nome);
+
+    if (!ok) falhas++;
+}
+
+void libera(polynomial p) {
+
+    for (int i = 0; i < p.numTerms; i++) {
+
+        if (p.terms[i].big != NULL) {
+
+            free(p.terms[i].big->limb);
+            free(p.terms[i].big);
+        }
+    }
+
+    free(p.terms);
+}
+
+// x + r, com r em decimal
+polynomial linear(const char* r) {
+
+    polynomial p = pCreate(2);
+
+    p.terms[0] = setTerms(1, 1);
+    p.terms[1] = setBigTerms(r, 0);
+
+    return p;
+}
+
+polynomial produto(polynomial a, polynomial b) {
+
+    polynomial p = pMul(a, b);
+
+    libera(a);
+    libera(b);
+
+    return p;
+}
+
+int iguais(polynomial a, polynomial b) {
+
+    polynomial x = pDense(a), y = pDense(b);
+    int ok = (x.numTerms == y.numTerms);
+
+    for (int i = 0; ok && i < x.numTerms; i++) {
+
+        term s = x.terms[i], t = y.terms[i];
+
+        ok = (s.exponent == t.exponent) && ((s.big == NULL) == (t.big == NULL));
+
+        if (ok && s.big == NULL) ok = (s.coefficient == t.coefficient);
+        else if (ok) ok = (s.big->sign == t.big->sign && s.big->size == t.big->size &&
+                           memcmp(s.big->limb, t.big->limb, s.big->size * sizeof(unsigned long long)) == 0);
+    }
+
+    libera(x);
+    libera(y);
+
+    return ok;
+}
+
+int contem(rootInterval r, long double x) {
+
+    return (long double)r.leftNum / r.leftDen <= x && x <= (long double)r.rightNum / r.rightDen;
+}
+
+int main() {
+
+    // pGcd((x - 10^12)(x + 1), (x - 10^12)(x + 2)) = x - 10^12
+    polynomial a = produto(linear("-1000000000000"), linear("1"));
+    polynomial b = produto(linear("-1000000000000"), linear("2"));
+    polynomial esperado = linear("-1000000000000");
+    polynomial g = pGcd(a, b);
+
+    verifica(iguais(g, esperado), "pGcd com coeficientes no heap");
+    libera(g);
+
+    // pGcd(0, 3*10^12 x + 6*10^12) mantém o conteúdo
+    polynomial zero = pCreate(1);
+    polynomial c = pCreate(2);
+
+    c.terms[0] = setBigTerms("3000000000000", 1);
+    c.terms[1] = setBigTerms("6000000000000", 0);
+    g = pGcd(zero, c);
+    verifica(iguais(g, c), "pGcd com polinomio nulo");
+    libera(g);
+    libera(zero);
+    libera(c);
+
+    // squareFree((x - 10^12)^2) = 1 * (x - 10^12)^2
+    polynomial q = pMul(esperado, esperado);
+    int numParts = 0;
+    polynomial *parts = squareFree(q, &numParts);
+    polynomial um = pCreate(1);
+
+    um.terms[0] = setTerms(1, 0);
+    verifica(numParts == 2 && iguais(parts[0], um) && iguais(parts[1], esperado), "squareFree com coeficientes no heap");
+
+    for (int i = 0; i < numParts; i++) libera(parts[i]);
+
+    free(parts);
+
+    // pRealRoots((x - 10^12)^2 (x + 1))
+    polynomial mais1 = linear("1");
+    polynomial r = pMul(q, mais1);
+    int numRoots = 0;
+    rootInterval *roots = pRealRoots(r, &numRoots);
+
+    verifica(numRoots == 2 && contem(roots[0], -1) && contem(roots[1], 1e12L), "pRealRoots com raiz dupla no heap");
+    free(roots);
+    libera(r);
+    libera(q);
+    libera(mais1);
+
+    // pRealRoots(x^2 - 10^20), refinando com pRefineRoot
+    polynomial s = pCreate(2);
+
+    s.terms[0] = setTerms(1, 2);
+    s.terms[1] = setBigTerms("-100000000000000000000", 0);
+    roots = pRealRoots(s, &numRoots);
+
+    int refinou = (numRoots == 2);
+
+    for (int i = 0; i < numRoots; i++) refinou = refinou && pRefineRoot(s, &roots[i], 100);
+
+    verifica(refinou && contem(roots[0], -1e10L) && contem(roots[1], 1e10L), "pRealRoots e pRefineRoot em x^2 - 10^20");
+    free(roots);
+
+    // Sem raízes de unidade: x^2 - 10^20 não é produto de ciclotômicos
+    verifica(!isCyclotomicProduct(s) && findN(s) == 0 && !dividesXPowerNMinusOne(s, 4), "testes ciclotomicos com coeficientes no heap");
+    libera(s);
+
+    // zassenhaus não trata coeficientes no heap: 2(x - 10^12)(x + 1) é redutível,
+    // e devolvê-lo como um único fator o faria parecer irredutível
+    polynomial dois = pCreate(1);
+
+    dois.terms[0] = setTerms(2, 0);
+
+    polynomial z = pMul(a, dois);
+    int numFactors = 0;
+    polynomial *factors = zassenhaus(z, &numFactors);
+
+    verifica(factors == NULL && numFactors == -1, "zassenhaus recusa coeficientes no heap");
+    verifica(pHasBig(z) && !pHasBig(um), "pHasBig");
+
+    libera(z);
+    libera(dois);
+    libera(um);
+    libera(esperado);
+    libera(a);
+    libera(b);
+
+    printf("%d falha(s)\n", falhas);
+
+    return falhas != 0;
+}